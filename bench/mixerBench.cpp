@@ -0,0 +1,1566 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: mixerBench.cpp
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// DESCRIPTION:
+// * Micro benchmarks for the mixer classes.
+// * Every case reports the wall-clock time, the amount of heap allocations and
+// the amount of bytes allocated per operation.
+// * Heap traffic is measured by replacing the global operator new/delete, so
+// any copy of a dataset shows up as an allocation. Allocations are counted
+// atomically, as threaded cases allocate on several threads at once, and
+// those of every thread running during a case are charged to it.
+// * With --counters, timed cases also report hardware counters per value:
+// cycles, instructions (and their ratio, IPC), L1 data cache read misses,
+// last level cache misses and branch misses. Construction cases, which make
+// no values, report them per operation.
+// * Usage:
+//   mixerBench [--counters]
+
+// ASSUMPTIONS:
+// * Built with optimizations enabled (see compilebench.ps1).
+// * Cases come in before/after pairs (i.e. copying then moving path, unpooled
+// then pooled path), so the difference between them is the cost removed.
+// * Counters are read through perf_event_open on Linux, counting user space
+// only, which is all an unprivileged process may count. Counters the host
+// does not offer (i.e. in most virtual machines) print as n/a, and on other
+// platforms --counters is refused with a note, the timings are unaffected.
+// * Counters are inherited by threads started while they run, so threaded
+// cases count their workers too. Threads of the default executor are started
+// beforehand, and are not counted.
+// * Counters are opened as one group, led by cycles, which the kernel only
+// schedules as a whole. Multiplexed groups are scaled up by the share of the
+// time they ran, with one scale for every counter, so ratios such as IPC
+// compare counts taken over the same time.
+// * Counters are reported per value wherever a case knows how many values an
+// operation pings, sorts, filters or moves, which it passes to its runner, so
+// cases of different sizes compare (i.e. "ping(4096)" against "ping()").
+// Construction cases pass none, and report per operation.
+
+
+#include <algorithm>  // copy, sort, shuffle, max
+#include <atomic>  // atomic
+#include <chrono>  // steady_clock
+#include <cstddef>  // size_t
+#include <cstdint>  // int16_t, int64_t, uint32_t, uint64_t
+#include <cstdlib>  // malloc, free
+#include <cstring>  // memmove
+#include <iomanip>  // setw, setprecision
+#include <iostream>  // cout, cerr
+#include <memory>  // make_shared, unique_ptr
+#include <mutex>  // mutex, lock_guard
+#include <new>  // bad_alloc
+#include <random>  // mt19937, mt19937_64
+#include <string>  // string, to_string
+#include <thread>  // thread, hardware_concurrency
+#include <utility>  // move
+#include <vector>  // vector
+
+
+#if defined(__linux__)
+#include <linux/perf_event.h>  // perf_event_attr, PERF_*
+#include <sys/ioctl.h>  // ioctl
+#include <sys/syscall.h>  // syscall, __NR_perf_event_open
+#include <unistd.h>  // read, close
+#define MIXER_BENCH_PERF
+#endif
+
+
+#include "../include/dubMix.h"
+#include "../include/mixAsync.h"
+#include "../include/mixKernels.h"
+#include "../include/mixPipeline.h"
+#include "../include/mixPlan.h"
+#include "../include/mixTopology.h"
+#include "../include/mixValue.h"
+#include "../include/multiMix.h"
+#include "../include/packedDataset.h"
+#include "../include/numMixer.h"
+#include "../include/polyMix.h"
+#include "../include/randomReservoir.h"
+#include "../include/replenishPolicy.h"
+#include "../include/shardedMix.h"
+#include "../include/sharedMix.h"
+#include "../include/streamMix.h"
+
+
+static std::atomic<std::size_t> gAllocCount(0);
+static std::atomic<std::size_t> gAllocBytes(0);
+
+
+void* operator new(std::size_t size)
+{
+	// relaxed: workers allocate concurrently, only the totals matter
+	gAllocCount.fetch_add(1, std::memory_order_relaxed);
+	gAllocBytes.fetch_add(size, std::memory_order_relaxed);
+	void* p = std::malloc(size ? size : 1);
+	if (!p) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+
+__attribute__((noinline)) void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+
+__attribute__((noinline)) void operator delete(void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+// Description:
+// * Counts every allocation made through the global operator new.
+
+
+static const unsigned int COUNTERS = 5;
+static const char* const COUNTER_NAMES[COUNTERS] = {
+	"cycles", "instrs", "L1d miss", "LLC miss", "br miss"
+};
+static int gCounterFds[COUNTERS] = { -1, -1, -1, -1, -1 };
+static int gCounterLeader = -1;
+static bool gCountersOn = false;
+// Cycles, instructions, L1 data cache read misses, last level cache misses
+// and branch misses, the descriptor counting each (-1 if unavailable), the
+// descriptor leading their group, and whether --counters was given.
+
+
+bool openCounters()
+{
+#if defined(MIXER_BENCH_PERF)
+	const std::uint64_t L1D_READ_MISS = PERF_COUNT_HW_CACHE_L1D |
+		(PERF_COUNT_HW_CACHE_OP_READ << 8) |
+		(PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+	const std::uint32_t TYPES[COUNTERS] = {
+		PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE,
+		PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE
+	};
+	const std::uint64_t CONFIGS[COUNTERS] = {
+		PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, L1D_READ_MISS,
+		PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+	};
+
+	// the first counter opened leads the group, the others follow it
+	for (unsigned int c = 0; c < COUNTERS; ++c) {
+		perf_event_attr attr = perf_event_attr();
+		attr.size = sizeof(attr);
+		attr.type = TYPES[c];
+		attr.config = CONFIGS[c];
+		attr.disabled = (gCounterLeader < 0);
+		attr.inherit = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		attr.read_format = PERF_FORMAT_GROUP |
+						   PERF_FORMAT_TOTAL_TIME_ENABLED |
+						   PERF_FORMAT_TOTAL_TIME_RUNNING;
+		gCounterFds[c] = syscall(__NR_perf_event_open, &attr, 0, -1,
+								 gCounterLeader, 0);
+		if (gCounterLeader < 0) {
+			gCounterLeader = gCounterFds[c];
+		}
+	}
+	return gCounterLeader >= 0;
+#else
+	return false;
+#endif
+}
+// Description:
+// * Opens every counter the host offers, as one group, for the calling
+// process and the threads it starts. The counters of a group are scheduled
+// together, so they all count over the same time.
+// * Returns whether any counter could be opened.
+
+
+void startCounters()
+{
+#if defined(MIXER_BENCH_PERF)
+	if (gCounterLeader >= 0) {
+		ioctl(gCounterLeader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+		ioctl(gCounterLeader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	}
+#endif
+}
+// Description:
+// * Zeroes and starts the counters.
+
+
+void pauseCounters(bool paused)
+{
+#if defined(MIXER_BENCH_PERF)
+	if (gCounterLeader >= 0) {
+		ioctl(gCounterLeader,
+			  paused ? PERF_EVENT_IOC_DISABLE : PERF_EVENT_IOC_ENABLE,
+			  PERF_IOC_FLAG_GROUP);
+	}
+#else
+	(void)paused;
+#endif
+}
+// Description:
+// * Stops ("paused") or restarts the counters, keeping their counts.
+
+
+void stopCounters(double counts[COUNTERS])
+{
+	for (unsigned int c = 0; c < COUNTERS; ++c) {
+		counts[c] = -1;
+	}
+#if defined(MIXER_BENCH_PERF)
+	if (gCounterLeader < 0) {
+		return;
+	}
+	ioctl(gCounterLeader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+	// counter amount, time enabled, time running, then a value per counter
+	std::uint64_t reading[3 + COUNTERS];
+	ssize_t bytes = read(gCounterLeader, reading, sizeof(reading));
+	if (bytes < static_cast<ssize_t>(3 * sizeof(std::uint64_t)) ||
+		!reading[2]) {
+		return;
+	}
+	// one scale for the whole group, so ratios such as IPC are exact
+	const double SCALE = double(reading[1]) / reading[2];
+	std::uint64_t value = 0;
+	for (unsigned int c = 0; c < COUNTERS && value < reading[0]; ++c) {
+		if (gCounterFds[c] >= 0) {
+			counts[c] = reading[3 + value++] * SCALE;
+		}
+	}
+#endif
+}
+// Description:
+// * Stops the counters, and stores their counts into "counts", scaled for
+// multiplexing, -1 for those unavailable.
+
+
+void printCounters(const double counts[COUNTERS],
+				   double ops,
+				   unsigned int values)
+{
+	const double UNITS = (values ? ops * values : ops);
+	std::cout << (values ? "    per value:" : "    per op:")
+			  << std::fixed << std::setprecision(2);
+	for (unsigned int c = 0; c < COUNTERS; ++c) {
+		std::cout << "  " << COUNTER_NAMES[c] << ' ';
+		if (counts[c] < 0) {
+			std::cout << "n/a";
+		} else {
+			std::cout << counts[c] / UNITS;
+		}
+	}
+	std::cout << "  IPC ";
+	if (counts[0] > 0 && counts[1] >= 0) {
+		std::cout << counts[1] / counts[0];
+	} else {
+		std::cout << "n/a";
+	}
+	std::cout << std::endl;
+}
+// Description:
+// * Prints "counts" per value, over "ops" operations of "values" values
+// each, or per operation if "values" is 0, and instructions per cycle, under
+// the timings of a case.
+
+
+template <typename Setup, typename Work>
+void runBench(const std::string& name,
+			  unsigned int reps,
+			  Setup setup,
+			  Work work,
+			  unsigned int values = 0)
+{
+	setup();
+
+	double counts[COUNTERS];
+	if (gCountersOn) {
+		startCounters();
+	}
+	std::size_t allocCount = gAllocCount.load(std::memory_order_relaxed);
+	std::size_t allocBytes = gAllocBytes.load(std::memory_order_relaxed);
+	auto start = std::chrono::steady_clock::now();
+	for (unsigned int i = 0; i < reps; ++i) {
+		work(i);
+	}
+	auto stop = std::chrono::steady_clock::now();
+	allocCount = gAllocCount.load(std::memory_order_relaxed) - allocCount;
+	allocBytes = gAllocBytes.load(std::memory_order_relaxed) - allocBytes;
+	if (gCountersOn) {
+		stopCounters(counts);
+	}
+
+	double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+	std::cout << std::left << std::setw(44) << name << std::right
+			  << std::fixed << std::setprecision(1)
+			  << std::setw(14) << ns / reps << " ns/op"
+			  << std::setw(10) << double(allocCount) / reps << " allocs/op"
+			  << std::setw(14) << double(allocBytes) / reps << " B/op"
+			  << std::endl;
+	if (gCountersOn) {
+		printCounters(counts, reps, values);
+	}
+}
+// Description:
+// * Runs "setup" untimed, then times "reps" calls of "work(i)", each making
+// "values" values (0 for constructions).
+// * Prints the time, allocations and bytes allocated per call, and the
+// counters per value, or per call for constructions, with --counters.
+
+
+template <typename Setup, typename Work, typename Idle>
+void runLatencyBench(const std::string& name,
+					 unsigned int reps,
+					 Setup setup,
+					 Work work,
+					 Idle idle,
+					 unsigned int values = 0)
+{
+	setup();
+
+	double counts[COUNTERS];
+	std::vector<double> ns(reps);
+	if (gCountersOn) {
+		startCounters();
+	}
+	for (unsigned int i = 0; i < reps; ++i) {
+		auto start = std::chrono::steady_clock::now();
+		work(i);
+		auto stop = std::chrono::steady_clock::now();
+		ns[i] = std::chrono::duration<double, std::nano>(stop - start).count();
+		if (gCountersOn) {
+			pauseCounters(true);
+		}
+		idle();
+		if (gCountersOn) {
+			pauseCounters(false);
+		}
+	}
+	if (gCountersOn) {
+		stopCounters(counts);
+	}
+	std::sort(ns.begin(), ns.end());
+
+	std::cout << std::left << std::setw(44) << name << std::right
+			  << std::fixed << std::setprecision(1)
+			  << std::setw(10) << ns[reps / 2] << " ns p50"
+			  << std::setw(10) << ns[reps * 99 / 100] << " ns p99"
+			  << std::setw(10) << ns[reps * 999 / 1000] << " ns p99.9"
+			  << std::endl;
+	if (gCountersOn) {
+		printCounters(counts, reps, values);
+	}
+}
+// Description:
+// * Runs "setup" untimed, then times "reps" calls of "work(i)" one by one,
+// each making "values" values, calling "idle()" untimed after each.
+// * Prints the median and tail latencies of a call, and the counters per
+// value with --counters. "idle()" is not counted.
+
+
+static const unsigned int PING_VALUES = 10;
+// Values of an ordinary ping (i.e. multiMix::ping()), for the counters.
+
+
+std::vector<int> makeDataset(unsigned int size)
+{
+	std::vector<int> dataset(size);
+	for (unsigned int i = 0; i < size; ++i) {
+		dataset[i] = i % 99 + 2;
+	}
+	return dataset;
+}
+// Description:
+// * Returns a deterministic dataset of values 2-100 of size "size".
+
+
+multiMix makeMultiMix(unsigned int mixers, unsigned int size)
+{
+	multiMix mm;
+	for (unsigned int i = 0; i < mixers; ++i) {
+		mm += numMixer(makeDataset(size));
+	}
+	return mm;
+}
+// Description:
+// * Returns a multiMix holding "mixers" numMixers of dataset size "size".
+
+
+void benchConstruction()
+{
+	const unsigned int REPS = 200;
+	const unsigned int SIZE = 100000;
+	const std::vector<int> dataset = makeDataset(SIZE);
+
+	std::vector<std::vector<int> > datasets;
+	std::vector<numMixer> sink;
+	runBench("numMixer(lvalue dataset) [copy]", REPS,
+		[&]() { sink.clear(); sink.reserve(REPS); },
+		[&](unsigned int) { sink.emplace_back(dataset); });
+	runBench("numMixer(rvalue dataset) [move]", REPS,
+		[&]() {
+			sink.clear();
+			sink.reserve(REPS);
+			datasets.assign(REPS, dataset);
+		},
+		[&](unsigned int i) { sink.emplace_back(std::move(datasets[i])); });
+
+	std::vector<numMixer> sources;
+	runBench("numMixer(const numMixer&) [copy]", REPS,
+		[&]() {
+			sink.clear();
+			sink.reserve(REPS);
+			sources.assign(REPS, numMixer(dataset));
+		},
+		[&](unsigned int i) { sink.push_back(sources[i]); });
+	runBench("numMixer(numMixer&&) [move]", REPS,
+		[&]() {
+			sink.clear();
+			sink.reserve(REPS);
+			sources.assign(REPS, numMixer(dataset));
+		},
+		[&](unsigned int i) { sink.push_back(std::move(sources[i])); });
+}
+// Description:
+// * Compares constructing numMixers from copied and moved datasets/objects.
+
+
+void benchStacking()
+{
+	const unsigned int REPS = 20;
+	const unsigned int MIXERS = 100;
+	const unsigned int SIZE = 10000;
+
+	std::vector<multiMix> lhs;
+	std::vector<multiMix> rhs;
+	auto setup = [&]() {
+		lhs.assign(REPS, multiMix());
+		rhs.assign(REPS, makeMultiMix(MIXERS, SIZE));
+	};
+	runBench("multiMix += const multiMix& [copy]", REPS, setup,
+		[&](unsigned int i) { lhs[i] += rhs[i]; });
+	runBench("multiMix += multiMix&& [move]", REPS, setup,
+		[&](unsigned int i) { lhs[i] += std::move(rhs[i]); });
+
+	std::vector<numMixer> mixers;
+	auto nmSetup = [&]() {
+		lhs.assign(REPS, multiMix());
+		mixers.assign(REPS, numMixer(makeDataset(SIZE)));
+	};
+	runBench("multiMix += const numMixer& [copy]", REPS, nmSetup,
+		[&](unsigned int i) { lhs[i] += mixers[i]; });
+	runBench("multiMix += numMixer&& [move]", REPS, nmSetup,
+		[&](unsigned int i) { lhs[i] += std::move(mixers[i]); });
+
+	std::vector<dubMix> dms;
+	auto dmSetup = [&]() { dms.assign(2 * REPS, dubMix()); };
+	runBench("const dubMix& + const dubMix& [copy]", REPS, dmSetup,
+		[&](unsigned int i) { dms[2 * i] = dms[2 * i] + dms[2 * i + 1]; });
+	runBench("dubMix&& + const dubMix& [move]", REPS, dmSetup,
+		[&](unsigned int i) {
+			dms[2 * i] = std::move(dms[2 * i]) + dms[2 * i + 1];
+		});
+}
+// Description:
+// * Compares stacking large mixers by copy and by move.
+
+
+void benchChurn()
+{
+	const unsigned int REPS = 20000;
+	const unsigned int MIXERS = 1000;
+	const unsigned int BATCH = 64;
+
+	multiMix mm;
+	auto setup = [&]() {
+		mm = multiMix();
+		mm.addNumMixers(MIXERS);
+	};
+	auto churn = [&](unsigned int) {
+		mm.addNumMixers(BATCH);
+		mm.removeNumMixers(BATCH);
+	};
+	runBench("multiMix add/remove churn [unpooled]", REPS, setup, churn);
+	runBench("multiMix add/remove churn [pooled]", REPS,
+		[&]() {
+			setup();
+			mm.reserveNumMixers(BATCH);
+		},
+		churn);
+}
+// Description:
+// * Compares add/remove churn of "BATCH" numMixers with and without a
+// reservation in the dataset pool.
+
+
+void benchBulkConstruction()
+{
+	const unsigned int REPS = 5;
+	const unsigned int COUNT = 200000;
+
+	multiMix mm;
+	auto setup = [&]() { mm = multiMix(); };
+	runBench("addNumMixers(200000) [serial]", REPS, setup,
+		[&](unsigned int) { mm.addNumMixers(COUNT); });
+
+	unsigned int maxThreads = std::thread::hardware_concurrency();
+	for (unsigned int threads = 1; threads <= maxThreads; threads *= 2) {
+		runBench("addNumMixersParallel(200000, " +
+				 std::to_string(threads) + ")", REPS, setup,
+			[&](unsigned int) { mm.addNumMixersParallel(COUNT, threads); });
+	}
+}
+// Description:
+// * Compares serial and parallel bulk construction of numMixers, doubling the
+// thread count up to the hardware thread count.
+
+
+void interleaveBranchy(const int* even,
+					   const int* odd,
+					   int* out,
+					   std::size_t count)
+{
+	for (std::size_t i = 0; i < 2 * count; ++i) {
+		if (i % 2 == 0) {
+			out[i] = even[i / 2];
+		} else {
+			out[i] = odd[i / 2];
+		}
+	}
+}
+// Description:
+// * The interleave loop dubMix::ctl3 used before the mixKernels, kept as the
+// baseline.
+
+
+template <typename Drop>
+unsigned int purgeSwap(int* arr, unsigned int size, Drop drop)
+{
+	unsigned int newSize = size;
+	for (unsigned int i = size; i-- > 0;) {
+		if (drop(arr[i])) {
+			arr[i] = arr[newSize - 1];
+			--newSize;
+		}
+	}
+	return newSize;
+}
+// Description:
+// * The swap-and-shrink loop multiMix::purgePrimeNumbers used before
+// mixPipeline, over any drop predicate, kept as the baseline.
+
+
+unsigned int purgeDuplicatesSwap(int* arr, unsigned int size)
+{
+	int newSize = size;
+	for (int i = size - 1; i >= 1; --i) {
+		for (int j = i - 1; j >= 0; --j) {
+			if (arr[j] == arr[i]) {
+				arr[i] = arr[newSize - 1];
+				--newSize;
+				break;
+			}
+		}
+	}
+	return newSize;
+}
+// Description:
+// * The duplicate purge dubMix::ctl4 used before mixPipeline, kept as the
+// baseline.
+
+
+void joinSwap(int* out,
+			  unsigned int firstCount,
+			  const int* second,
+			  unsigned int secondCount)
+{
+	std::memmove(out + firstCount, second, secondCount * sizeof(int));
+}
+// Description:
+// * The join dubMix::ctl4 used before mixPipeline, moving the purged second
+// half of a ping down behind the first, kept as the baseline.
+
+
+void benchKernels()
+{
+	const unsigned int REPS = 200;
+	const unsigned int SIZE = 1 << 18;
+
+	std::vector<int> even = makeDataset(SIZE);
+	std::vector<int> odd = makeDataset(SIZE);
+	std::vector<int> out(2 * SIZE);
+	auto noSetup = []() {};
+	runBench("interleave 256K [i % 2 loop]", REPS, noSetup,
+		[&](unsigned int) {
+			interleaveBranchy(even.data(), odd.data(), out.data(), SIZE);
+		}, 2 * SIZE);
+	runBench("interleave 256K [scalar]", REPS, noSetup,
+		[&](unsigned int) {
+			interleaveScalar(even.data(), odd.data(), out.data(), SIZE);
+		}, 2 * SIZE);
+	runBench(std::string("interleave 256K [") + interleaveKernelName() + "]",
+			 REPS, noSetup,
+		[&](unsigned int) {
+			interleave(even.data(), odd.data(), out.data(), SIZE);
+		}, 2 * SIZE);
+
+	const unsigned int PING_REPS = 50;
+	const unsigned int PING_SIZE = 4096;
+	std::vector<dubMix> dms;
+	for (unsigned int ctl = 3; ctl <= 4; ++ctl) {
+		runBench("dubMix ctl" + std::to_string(ctl) + " ping(4096)", PING_REPS,
+			[&]() {
+				dms.assign(PING_REPS, dubMix());
+				for (auto& dm : dms) {
+					dm.setCtl(ctl);
+				}
+			},
+			[&](unsigned int i) { dms[i].ping(PING_SIZE); }, 2 * PING_SIZE);
+	}
+}
+// Description:
+// * Compares the interleave kernels against the original branchy loop, and
+// times large dubMix pings that use them.
+
+
+void benchPolyMix()
+{
+	const unsigned int REPS = 50;
+	const unsigned int ROUNDS = 4096;
+
+	numMixer even;
+	even.setControllerState(numMixer::EVEN);
+	numMixer odd;
+	odd.setControllerState(numMixer::ODD);
+
+	std::vector<polyMix> pms;
+	auto setupPlan = [&](const mixPlan& plan) {
+		return [&, plan]() {
+			pms.clear();
+			for (unsigned int i = 0; i < REPS; ++i) {
+				std::vector<numMixer> sources;
+				for (unsigned int s = 0; s < plan.sourceCount(); ++s) {
+					sources.push_back(s % 2 ? odd : even);
+				}
+				pms.emplace_back(std::move(sources), plan);
+			}
+		};
+	};
+	auto ping = [&](unsigned int i) { pms[i].ping(); };
+
+	const mixPlan RR2(mixPlan::ROUND_ROBIN, { 1, 1 }, ROUNDS);
+	const mixPlan RR4(mixPlan::ROUND_ROBIN, { 3, 1, 2, 1 }, ROUNDS / 4);
+	const mixPlan BLOCKS4(mixPlan::BLOCKS, { 4, 4, 4, 4 }, ROUNDS / 8);
+	const mixPlan CONCAT2(mixPlan::CONCATENATE, { 1, 1 }, ROUNDS, true);
+	runBench("polyMix 2-way round-robin {1,1} x4096", REPS,
+		setupPlan(RR2), ping, RR2.pullTotal());
+	runBench("polyMix 4-way round-robin {3,1,2,1} x1024", REPS,
+		setupPlan(RR4), ping, RR4.pullTotal());
+	runBench("polyMix 4-way blocks {4,4,4,4} x512", REPS,
+		setupPlan(BLOCKS4), ping, BLOCKS4.pullTotal());
+	runBench("polyMix 2-way concatenate+dedup {4096,4096}", REPS,
+		setupPlan(CONCAT2), ping, CONCAT2.pullTotal());
+}
+// Description:
+// * Times large polyMix pings over compiled plans. The 2-way cases mirror the
+// dubMix ctl3/ctl4 cases above.
+
+
+void benchScheduler()
+{
+	const unsigned int REPS = 100000;
+	const unsigned int MIXERS = 100000;
+
+	multiMix mm;
+	auto setupPolicy = [&](multiMix::SchedulePolicy policy) {
+		return [&, policy]() {
+			mm = multiMix();
+			mm.addNumMixers(MIXERS);
+			mm.setSchedulePolicy(policy);
+		};
+	};
+	auto ping = [&](unsigned int) { mm.ping(); };
+
+	runBench("multiMix ping [STACK]", REPS,
+		setupPolicy(multiMix::STACK), ping, PING_VALUES);
+	runBench("multiMix ping [COUNTDOWN]", REPS,
+		setupPolicy(multiMix::COUNTDOWN), ping, PING_VALUES);
+	runBench("multiMix ping [ROUND_ROBIN]", REPS,
+		setupPolicy(multiMix::ROUND_ROBIN), ping, PING_VALUES);
+	runBench("multiMix ping [LEAST_RECENTLY_USED]", REPS,
+		setupPolicy(multiMix::LEAST_RECENTLY_USED), ping, PING_VALUES);
+}
+// Description:
+// * Times multiMix pings under each schedule policy, over a large stack. Under
+// STACK the top numMixer is soon exhausted, so most pings fail.
+
+
+void benchResults()
+{
+	const unsigned int REPS = 10000;
+	const unsigned int MIXERS = 100000;
+
+	std::vector<dubMix> dms;
+	for (unsigned int ctl = 1; ctl <= 4; ++ctl) {
+		auto setup = [&, ctl]() {
+			dms.assign(REPS, dubMix());
+			for (auto& dm : dms) {
+				dm.setCtl(ctl);
+			}
+		};
+		std::string name = "dubMix ctl" + std::to_string(ctl) + " ping()";
+		// ctl 3 and 4 ping both numMixers
+		const unsigned int VALUES = (ctl < 3 ? 1 : 2) * PING_VALUES;
+		runBench(name + " [std::vector]", REPS, setup,
+			[&](unsigned int i) { dms[i].ping().toVector(); }, VALUES);
+		runBench(name + " [mixResult]", REPS, setup,
+			[&](unsigned int i) { dms[i].ping(); }, VALUES);
+	}
+
+	multiMix mm;
+	auto setup = [&]() {
+		mm = multiMix();
+		mm.addNumMixers(MIXERS);
+		mm.setSchedulePolicy(multiMix::ROUND_ROBIN);
+	};
+	runBench("multiMix ping [std::vector]", REPS, setup,
+		[&](unsigned int) { mm.ping().toVector(); }, PING_VALUES);
+	runBench("multiMix ping [mixResult]", REPS, setup,
+		[&](unsigned int) { mm.ping(); }, PING_VALUES);
+}
+// Description:
+// * Compares ordinary pings returning a std::vector<int>, as they used to,
+// against returning a mixResult, which holds them inline.
+
+
+template <typename T>
+void benchValueType(const std::string& type)
+{
+	const unsigned int KERNEL_REPS = 200;
+	const unsigned int SIZE = 1 << 18;
+	const unsigned int REPS = 20;
+	const unsigned int COUNT = 10000;
+	const unsigned int PING_REPS = 100000;
+
+	std::vector<T> even(SIZE, 2);
+	std::vector<T> odd(SIZE, 3);
+	std::vector<T> out(2 * SIZE);
+	runBench("interleave 256K " + type + " [" + interleaveKernelName() + "]",
+			 KERNEL_REPS, []() {},
+		[&](unsigned int) {
+			interleave(even.data(), odd.data(), out.data(), SIZE);
+		}, 2 * SIZE);
+
+	basicMultiMix<T> mm;
+	runBench("addNumMixers(10000) " + type, REPS,
+		[&]() { mm = basicMultiMix<T>(); },
+		[&](unsigned int) { mm.addNumMixers(COUNT); });
+	runBench("multiMix ping [COUNTDOWN] " + type, PING_REPS,
+		[&]() {
+			mm = basicMultiMix<T>();
+			mm.setSchedulePolicy(basicMultiMix<T>::COUNTDOWN);
+			mm.addNumMixers(COUNT);
+		},
+		[&](unsigned int) { mm.ping(); }, PING_VALUES);
+}
+// Description:
+// * Times the interleave kernel, bulk construction and pings for value type
+// T. Narrower types move more values per vector, and take fewer bytes per
+// dataset.
+
+
+void benchImplicit()
+{
+	const unsigned int REPS = 50;
+	const unsigned int SIZE = 1000000;
+	const unsigned int PING_REPS = 200000;
+
+	std::vector<numMixer> sink;
+	auto sinkSetup = [&]() { sink.clear(); sink.reserve(REPS); };
+	runBench("numMixer(1M values) [vector]", REPS, sinkSetup,
+		[&](unsigned int) {
+			std::vector<int> dataset(SIZE);
+			for (unsigned int i = 0; i < SIZE; ++i) {
+				dataset[i] = i + 1;
+			}
+			sink.emplace_back(std::move(dataset));
+		});
+	runBench("numMixer(1M values) [implicit range]", REPS, sinkSetup,
+		[&](unsigned int) {
+			sink.emplace_back(numMixer::range{ 1, SIZE, 1 });
+		});
+
+	std::vector<dubMix> dubs;
+	runBench("dubMix()", REPS,
+		[&]() { dubs.clear(); dubs.reserve(REPS); },
+		[&](unsigned int) { dubs.emplace_back(); });
+
+	numMixer nm;
+	std::vector<int> returnValues(PING_VALUES);
+	auto pingSetup = [&](bool implicit) {
+		return [&, implicit]() {
+			nm = numMixer(numMixer::range{ 1, SIZE, 3 });
+			if (!implicit) {
+				nm = numMixer(nm.dataset());
+			}
+			nm.setControllerState(numMixer::EVEN);
+			nm.setReplenishPolicy(
+				std::make_shared<sharedBudget>(PING_REPS, 20));
+		};
+	};
+	runBench("numMixer EVEN ping(10) [vector]", PING_REPS, pingSetup(false),
+		[&](unsigned int) { nm.ping(returnValues); }, PING_VALUES);
+	runBench("numMixer EVEN ping(10) [implicit range]", PING_REPS,
+			 pingSetup(true),
+		[&](unsigned int) { nm.ping(returnValues); }, PING_VALUES);
+}
+// Description:
+// * Compares numMixers over a 1M value range held in a vector against the
+// same range held implicitly, and shows the cost of a default dubMix, whose
+// two numMixers are implicit.
+// * The vector case draws indexes until it hits an even value, the implicit
+// case draws among the even values only.
+
+
+void benchStream()
+{
+	const unsigned int REPS = 20;
+	const unsigned int STREAM = 1000000;
+	const unsigned int CAPACITY = 1000;
+	const unsigned int PING_REPS = 200000;
+
+	numMixer nm;
+	runBench("ingest 1M values [collect, then numMixer]", REPS, []() {},
+		[&](unsigned int) {
+			std::vector<int> dataset;
+			for (unsigned int i = 0; i < STREAM; ++i) {
+				dataset.push_back(i);
+			}
+			nm = numMixer(std::move(dataset));
+		}, STREAM);
+
+	std::unique_ptr<streamMix> sm;
+	auto streamSetup = [&]() { sm.reset(new streamMix(CAPACITY)); };
+	runBench("ingest 1M values [streamMix(1000)]", REPS, streamSetup,
+		[&](unsigned int) {
+			for (unsigned int i = 0; i < STREAM; ++i) {
+				sm->ingest(i);
+			}
+			nm = sm->snapshot();
+		}, STREAM);
+
+	std::vector<int> returnValues(PING_VALUES);
+	runBench("streamMix EVEN ping(10)", PING_REPS,
+		[&]() {
+			streamSetup();
+			for (unsigned int i = 0; i < STREAM; ++i) {
+				sm->ingest(i);
+			}
+		},
+		[&](unsigned int) { sm->ping(returnValues, numMixer::EVEN); },
+		PING_VALUES);
+}
+// Description:
+// * Compares building a numMixer from a 1M value stream by collecting all of
+// it against keeping a 1000 value reservoir sample of it. The sample skips
+// most of the stream without drawing from the rng.
+
+
+void benchPacked()
+{
+	const unsigned int KERNEL_REPS = 200;
+	const unsigned int SIZE = 1 << 18;
+	const unsigned int REPS = 10;
+	const unsigned int COUNT = 100000;
+	const unsigned int PING_REPS = 200000;
+	const unsigned int BULK_REPS = 2000;
+	const unsigned int BULK = 4096;
+
+	const packedDataset PACKED(makeDataset(SIZE));
+	std::vector<int> out(SIZE);
+	runBench("unpackBits 256K x 7 bits [scalar]", KERNEL_REPS, []() {},
+		[&](unsigned int) {
+			unpackBitsScalar(PACKED.words(), PACKED.bitWidth(), PACKED.base(),
+							 out.data(), SIZE);
+		}, SIZE);
+	runBench("unpackBits 256K x 7 bits [" +
+			 std::string(unpackBitsKernelName()) + "]", KERNEL_REPS, []() {},
+		[&](unsigned int) { PACKED.unpack(out.data()); }, SIZE);
+
+	multiMix mm;
+	auto setup = [&](bool packed) {
+		return [&, packed]() {
+			mm = multiMix();
+			mm.setPackedDatasets(packed);
+		};
+	};
+	runBench("addNumMixers(100000) [vector]", REPS, setup(false),
+		[&](unsigned int) { mm.addNumMixers(COUNT); });
+	runBench("addNumMixers(100000) [packed]", REPS, setup(true),
+		[&](unsigned int) { mm.addNumMixers(COUNT); });
+
+	auto pingSetup = [&](bool packed) {
+		return [&, packed]() {
+			setup(packed)();
+			mm.setSchedulePolicy(multiMix::COUNTDOWN);
+			mm.addNumMixers(COUNT);
+		};
+	};
+	runBench("multiMix ping [COUNTDOWN, vector]", PING_REPS, pingSetup(false),
+		[&](unsigned int) { mm.ping(); }, PING_VALUES);
+	runBench("multiMix ping [COUNTDOWN, packed]", PING_REPS, pingSetup(true),
+		[&](unsigned int) { mm.ping(); }, PING_VALUES);
+
+	numMixer nm;
+	std::vector<int> returnValues(BULK);
+	auto bulkSetup = [&](bool packed) {
+		return [&, packed]() {
+			nm = numMixer(makeDataset(30));
+			if (packed) {
+				nm.pack();
+			}
+			nm.setControllerState(numMixer::EVEN);
+			nm.setReplenishPolicy(
+				std::make_shared<sharedBudget>(BULK_REPS, 20));
+		};
+	};
+	runBench("numMixer EVEN ping(4096) [vector]", BULK_REPS, bulkSetup(false),
+		[&](unsigned int) { nm.ping(returnValues); }, BULK);
+	runBench("numMixer EVEN ping(4096) [packed]", BULK_REPS, bulkSetup(true),
+		[&](unsigned int) { nm.ping(returnValues); }, BULK);
+}
+// Description:
+// * Times the unpack kernel, and compares multiMix datasets of 30 values
+// 2-100 held in vectors against packed into 7 bits each: bytes allocated per
+// 100000 numMixers, and pings. Bulk pings of a packed numMixer unpack its
+// dataset once per ping.
+
+
+void benchSorted()
+{
+	const unsigned int KERNEL_REPS = 2000;
+	const unsigned int SIZE = 4096;
+
+	std::vector<int> values = makeDataset(SIZE);
+	std::shuffle(values.begin(), values.end(), std::mt19937(1));
+	std::vector<std::int64_t> wide(SIZE);
+	std::mt19937_64 wideEng(1);
+	for (auto& val : wide) {
+		val = static_cast<std::int64_t>(wideEng());
+	}
+	std::vector<int> out(SIZE);
+	std::vector<std::int64_t> wideOut(SIZE);
+	// copied within the rep, so every rep sorts unsorted values
+	runBench("sort 4096 values 2-100 [std::sort]", KERNEL_REPS, []() {},
+		[&](unsigned int) {
+			out = values;
+			std::sort(out.begin(), out.end());
+		}, SIZE);
+	runBench("sort 4096 values 2-100 [sortValues]", KERNEL_REPS, []() {},
+		[&](unsigned int) {
+			out = values;
+			sortValues(out.data(), SIZE);
+		}, SIZE);
+	runBench("sort 4096 int64 [std::sort]", KERNEL_REPS, []() {},
+		[&](unsigned int) {
+			wideOut = wide;
+			std::sort(wideOut.begin(), wideOut.end());
+		}, SIZE);
+	runBench("sort 4096 int64 [sortValues]", KERNEL_REPS, []() {},
+		[&](unsigned int) {
+			wideOut = wide;
+			sortValues(wideOut.data(), SIZE);
+		}, SIZE);
+
+	std::vector<dubMix> dms;
+	auto dubSetup = [&](unsigned int ctl, unsigned int reps, bool sorted) {
+		return [&, ctl, reps, sorted]() {
+			dms.assign(reps, dubMix());
+			for (auto& dm : dms) {
+				dm.setCtl(ctl);
+				dm.setSortedOutput(sorted);
+			}
+		};
+	};
+	const unsigned int PING_REPS = 20000;
+	const unsigned int BULK_REPS = 50;
+	for (unsigned int ctl = 3; ctl <= 4; ++ctl) {
+		const std::string NAME = "dubMix ctl" + std::to_string(ctl);
+		runBench(NAME + " ping() [then std::sort]", PING_REPS,
+				 dubSetup(ctl, PING_REPS, false),
+			[&](unsigned int i) {
+				dubMix::mixResult result = dms[i].ping();
+				std::sort(result.begin(), result.end());
+			}, 2 * PING_VALUES);
+		runBench(NAME + " ping() [sorted output]", PING_REPS,
+				 dubSetup(ctl, PING_REPS, true),
+			[&](unsigned int i) { dms[i].ping(); }, 2 * PING_VALUES);
+		runBench(NAME + " ping(4096) [then std::sort]", BULK_REPS,
+				 dubSetup(ctl, BULK_REPS, false),
+			[&](unsigned int i) {
+				dubMix::mixResult result = dms[i].ping(SIZE);
+				std::sort(result.begin(), result.end());
+			}, 2 * SIZE);
+		runBench(NAME + " ping(4096) [sorted output]", BULK_REPS,
+				 dubSetup(ctl, BULK_REPS, true),
+			[&](unsigned int i) { dms[i].ping(SIZE); }, 2 * SIZE);
+	}
+
+	const unsigned int MIXERS = 100000;
+	multiMix mm;
+	auto multiSetup = [&](bool sorted) {
+		return [&, sorted]() {
+			mm = multiMix();
+			mm.setSchedulePolicy(multiMix::COUNTDOWN);
+			mm.setSortedOutput(sorted);
+			mm.addNumMixers(MIXERS);
+		};
+	};
+	runBench("multiMix ping [then std::sort]", PING_REPS, multiSetup(false),
+		[&](unsigned int) {
+			multiMix::mixResult result = mm.ping();
+			std::sort(result.begin(), result.end());
+		}, PING_VALUES);
+	runBench("multiMix ping [sorted output]", PING_REPS, multiSetup(true),
+		[&](unsigned int) { mm.ping(); }, PING_VALUES);
+}
+// Description:
+// * Compares sortValues() against std::sort on mixer-range and full-range
+// values, and pings followed by a std::sort, as consumers do, against pings
+// in sorted output mode.
+
+
+void benchPipeline()
+{
+	const unsigned int KERNEL_REPS = 2000;
+	const unsigned int SIZE = 4096;
+
+	std::vector<int> values = makeDataset(SIZE);
+	std::shuffle(values.begin(), values.end(), std::mt19937(1));
+	std::vector<int> out(SIZE);
+	// copied within the rep, so every rep filters the same values
+	runBench("no primes, 50-100, even 4096 [3 swap passes]", KERNEL_REPS,
+			 []() {},
+		[&](unsigned int) {
+			out = values;
+			unsigned int size = purgeSwap(out.data(), SIZE, [](int val) {
+				return mixValueTraits<int>::isPrime(val);
+			});
+			size = purgeSwap(out.data(), size, [](int val) {
+				return val < 50 || val > 100;
+			});
+			out.resize(purgeSwap(out.data(), size, [](int val) {
+				return (val & 1) != 0;
+			}));
+		}, SIZE);
+	mixPipeline filters = mixPipeline::primePurge();
+	filters.keepRange(50, 100).keepEven();
+	runBench("no primes, 50-100, even 4096 [mixPipeline]", KERNEL_REPS,
+			 []() {},
+		[&](unsigned int) {
+			out = values;
+			out.resize(filters.apply(out.data(), SIZE));
+		}, SIZE);
+
+	const unsigned int DEDUP_SIZE = 1024;
+	const std::vector<int> DEDUP_VALUES(values.begin(),
+										values.begin() + DEDUP_SIZE);
+	runBench("dedup 1024 values [swap loop]", KERNEL_REPS, []() {},
+		[&](unsigned int) {
+			out = DEDUP_VALUES;
+			out.resize(purgeDuplicatesSwap(out.data(), DEDUP_SIZE));
+		}, DEDUP_SIZE);
+	const mixPipeline DEDUP = mixPipeline::duplicatePurge();
+	runBench("dedup 1024 values [mixPipeline]", KERNEL_REPS, []() {},
+		[&](unsigned int) {
+			out = DEDUP_VALUES;
+			out.resize(DEDUP.apply(out.data(), DEDUP_SIZE));
+		}, DEDUP_SIZE);
+
+	// a ctl 4 ping of 10 per half, as pinged, before purging
+	const unsigned int HALF = 10;
+	const unsigned int JOIN_REPS = 200000;
+	numMixer evens(makeDataset(100));
+	numMixer odds(makeDataset(100));
+	evens.setControllerState(numMixer::EVEN);
+	odds.setControllerState(numMixer::ODD);
+	dubMix::mixResult pinged(2 * HALF);
+	evens.ping(pinged.data(), HALF);
+	odds.ping(pinged.data() + HALF, HALF);
+	dubMix::mixResult joined;
+	runBench("ctl4 purge and join 2x10 [swap loops]", JOIN_REPS, []() {},
+		[&](unsigned int) {
+			joined = pinged;
+			int* xOut = joined.data();
+			int* zOut = joined.data() + HALF;
+			unsigned int xSize = purgeDuplicatesSwap(xOut, HALF);
+			unsigned int zSize = purgeDuplicatesSwap(zOut, HALF);
+			joinSwap(joined.data(), xSize, zOut, zSize);
+			joined.resize(xSize + zSize);
+		}, 2 * HALF);
+	runBench("ctl4 purge and join 2x10 [mixPipeline]", JOIN_REPS, []() {},
+		[&](unsigned int) {
+			joined = pinged;
+			mixPipeline().apply(joined, true);
+		}, 2 * HALF);
+}
+// Description:
+// * Compares the swap-and-shrink purges the mixers ran before mixPipeline,
+// one pass per filter, against a fused pipeline, and the purge and join of a
+// ctl 4 ping as dubMix did it before against the pipeline pass now doing it.
+
+
+void benchLazy()
+{
+	const unsigned int REPS = 2000;
+	const unsigned int SIZE = 4096;
+	const unsigned int TAKE = 10;
+
+	numMixer nm;
+	auto setup = [&]() {
+		nm = numMixer(makeDataset(100));
+		nm.setControllerState(numMixer::EVEN);
+		nm.setReplenishPolicy(std::make_shared<sharedBudget>(REPS, 20));
+	};
+	std::vector<int> returnValues(SIZE);
+	int first[TAKE];
+	runBench("numMixer EVEN first 10 of 4096 [ping]", REPS, setup,
+		[&](unsigned int) {
+			nm.ping(returnValues);
+			std::copy(returnValues.begin(), returnValues.begin() + TAKE,
+					  first);
+		}, TAKE);
+	runBench("numMixer EVEN first 10 of 4096 [lazyPing]", REPS, setup,
+		[&](unsigned int) { nm.lazyPing(SIZE).read(first, TAKE); }, TAKE);
+	runBench("numMixer EVEN all of 4096 [ping]", REPS, setup,
+		[&](unsigned int) { nm.ping(returnValues); }, SIZE);
+	runBench("numMixer EVEN all of 4096 [lazyPing]", REPS, setup,
+		[&](unsigned int) {
+			nm.lazyPing(SIZE).read(returnValues.data(), SIZE);
+		}, SIZE);
+
+	// fresh dubMixes, so no rep finds its numMixers exhausted
+	const unsigned int DUB_REPS = 200;
+	std::vector<dubMix> dms;
+	auto dubSetup = [&]() { dms.assign(DUB_REPS, dubMix()); };
+	runBench("dubMix ctl3 first 10 of ping(4096) [ping]", DUB_REPS, dubSetup,
+		[&](unsigned int i) {
+			const dubMix::mixResult OUT = dms[i].ping(SIZE);
+			std::copy(OUT.begin(), OUT.begin() + TAKE, first);
+		}, TAKE);
+	runBench("dubMix ctl3 first 10 of ping(4096) [lazyPing]", DUB_REPS,
+			 dubSetup,
+		[&](unsigned int i) { dms[i].lazyPing(SIZE).read(first, TAKE); },
+		TAKE);
+}
+// Description:
+// * Compares consumers that read the first 10 values of a large ping, eagerly
+// pinged in full, against a lazy view drawing a single block, and the cost of
+// reading a whole ping through a view against pinging it.
+
+
+void benchShared()
+{
+	const unsigned int REPS = 10;
+	const unsigned int MIXERS = 100000;
+	const unsigned int PING_REPS = 200000;
+	const std::string NAME = "/mixerBench";
+
+	multiMix mm;
+	runBench("worker warm-up [addNumMixers(100000)]", REPS,
+		[&]() { mm = multiMix(); },
+		[&](unsigned int) { mm.addNumMixers(MIXERS); });
+
+	sharedMix::remove(NAME);
+	mm = multiMix();
+	mm.addNumMixers(MIXERS);
+	sharedMix creator = sharedMix::create(NAME, mm);
+	if (!creator.isAttached()) {
+		std::cout << "  shared memory unavailable" << std::endl;
+		return;
+	}
+	std::cout << "  segment of " << MIXERS << " numMixers: "
+			  << creator.bytes() << " B, shared by every worker" << std::endl;
+	sharedMix worker;
+	runBench("worker warm-up [sharedMix::attach]", REPS, []() {},
+		[&](unsigned int) { worker = sharedMix::attach(NAME); });
+
+	runBench("multiMix ping [COUNTDOWN]", PING_REPS,
+		[&]() {
+			mm = multiMix();
+			mm.setSchedulePolicy(multiMix::COUNTDOWN);
+			mm.addNumMixers(MIXERS);
+		},
+		[&](unsigned int) { mm.ping(); }, PING_VALUES);
+	runBench("sharedMix ping", PING_REPS, []() {},
+		[&](unsigned int) { worker.ping(); }, PING_VALUES);
+	sharedMix::remove(NAME);
+}
+// Description:
+// * Compares the warm-up of a worker that seeds its own multiMix against one
+// that attaches to a shared segment, and their pings.
+
+
+template <typename Setup, typename Work>
+void runThreadedBench(const std::string& name,
+					  unsigned int threadCount,
+					  unsigned int reps,
+					  Setup setup,
+					  Work work,
+					  unsigned int values = 0)
+{
+	setup();
+
+	double counts[COUNTERS];
+	if (gCountersOn) {
+		startCounters();
+	}
+	std::vector<std::thread> threads;
+	std::size_t allocCount = gAllocCount.load(std::memory_order_relaxed);
+	auto start = std::chrono::steady_clock::now();
+	for (unsigned int t = 0; t < threadCount; ++t) {
+		threads.emplace_back([&]() {
+			for (unsigned int i = 0; i < reps; ++i) {
+				work(i);
+			}
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	auto stop = std::chrono::steady_clock::now();
+	allocCount = gAllocCount.load(std::memory_order_relaxed) - allocCount;
+	if (gCountersOn) {
+		stopCounters(counts);
+	}
+
+	const double OPS = double(reps) * threadCount;
+	double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+	std::cout << std::left << std::setw(44) << name << std::right
+			  << std::fixed << std::setprecision(1)
+			  << std::setw(14) << ns / OPS << " ns/op"
+			  << std::setw(10) << 1000.0 * OPS / ns << " Mops/s"
+			  << std::setw(10) << double(allocCount) / OPS << " allocs/op"
+			  << std::endl;
+	if (gCountersOn) {
+		printCounters(counts, OPS, values);
+	}
+}
+// Description:
+// * Runs "setup" untimed, then times "threadCount" threads each making "reps"
+// calls of "work(i)", each making "values" values.
+// * Prints the aggregate time per call, throughput and allocations per call,
+// and the counters of every thread per value with --counters. Allocations
+// count those of every thread, including starting the threads themselves.
+
+
+void benchSharded()
+{
+	const unsigned int REPS = 100000;
+	const unsigned int MIXERS_PER_THREAD = 20000;
+	const unsigned int MAX_THREADS = std::max(4u,
+		std::thread::hardware_concurrency());
+
+	for (unsigned int threads = 1; threads <= MAX_THREADS; threads *= 2) {
+		const std::string SUFFIX = " [" + std::to_string(threads) + " threads]";
+
+		multiMix mm;
+		std::mutex lock;
+		runThreadedBench("multiMix ping, locked" + SUFFIX, threads, REPS,
+			[&]() {
+				mm = multiMix();
+				mm.setSchedulePolicy(multiMix::COUNTDOWN);
+				mm.addNumMixersParallel(threads * MIXERS_PER_THREAD);
+			},
+			[&](unsigned int) {
+				std::lock_guard<std::mutex> guard(lock);
+				mm.ping();
+			}, PING_VALUES);
+
+		std::unique_ptr<shardedMix> sm;
+		runThreadedBench("shardedMix ping" + SUFFIX, threads, REPS,
+			[&]() {
+				sm.reset(new shardedMix(threads));
+				sm->addNumMixersParallel(threads * MIXERS_PER_THREAD);
+			},
+			[&](unsigned int) { sm->ping(); }, PING_VALUES);
+		shardedMix::shardStats stats = sm->getStats();
+		std::cout << "  " << stats.steals << " of " << stats.pings
+				  << " pings stolen" << std::endl;
+	}
+}
+// Description:
+// * Compares aggregate ping throughput of a multiMix behind one lock against a
+// shardedMix with a shard per thread, as threads are added.
+
+
+void benchNuma()
+{
+	const unsigned int REPS = 200000;
+	const unsigned int MIXERS = 20000;
+
+	mixTopology topology = mixTopology::detect();
+	if (topology.nodeCount() < 2) {
+		topology = mixTopology::simulated(2);
+	}
+	std::cout << "  topology " << topology.toString()
+			  << (topology.isSimulated() ? " (simulated)" : "") << std::endl;
+
+	multiMix mm;
+	auto setup = [&]() {
+		topology.runOnNode(0, [&]() {
+			mm = multiMix();
+			mm.setSchedulePolicy(multiMix::COUNTDOWN);
+			mm.addNumMixers(MIXERS);
+		});
+	};
+	auto ping = [&](unsigned int) { mm.ping(); };
+	topology.runOnNode(0, [&]() {
+		runBench("multiMix ping, node 0 data [local]", REPS, setup, ping,
+				 PING_VALUES);
+	});
+	topology.runOnNode(1, [&]() {
+		runBench("multiMix ping, node 0 data [remote]", REPS, setup, ping,
+				 PING_VALUES);
+	});
+
+	const unsigned int THREADS = topology.cpuCount();
+	std::unique_ptr<shardedMix> sm;
+	auto pinnedPing = [&](unsigned int i) {
+		if (i == 0) {
+			sm->pinThread();
+		}
+		sm->ping();
+	};
+	runThreadedBench("shardedMix ping [unplaced]", THREADS, REPS,
+		[&]() {
+			sm.reset(new shardedMix(THREADS));
+			sm->addNumMixersParallel(THREADS * MIXERS);
+		},
+		pinnedPing, PING_VALUES);
+	runThreadedBench("shardedMix ping [placed, pinned]", THREADS, REPS,
+		[&]() {
+			sm.reset(new shardedMix(topology));
+			sm->addNumMixersParallel(THREADS * MIXERS);
+		},
+		pinnedPing, PING_VALUES);
+}
+// Description:
+// * Compares pings of a multiMix whose datasets were placed on node 0, from
+// node 0 (local) and node 1 (remote).
+// * Compares a shardedMix left to the scheduler against one placed on the
+// topology, with every pinging thread pinned next to its shard.
+// * Single-node hosts run on a simulated 2-node topology, which exercises the
+// placement but can not show a remote penalty.
+
+
+void benchReplenish()
+{
+	const unsigned int REPS = 200000;
+	const unsigned int SIZE = 30;
+
+	numMixer nm;
+	std::vector<int> returnValues(PING_VALUES);
+	runBench("long-running ping [rebuild when exhausted]", REPS,
+		[&]() { nm = numMixer(makeDataset(SIZE)); },
+		[&](unsigned int) {
+			if (!nm.ping(returnValues)) {
+				nm = numMixer(makeDataset(SIZE));
+				nm.ping(returnValues);
+			}
+		}, PING_VALUES);
+	runBench("long-running ping [sharedBudget]", REPS,
+		[&]() {
+			nm = numMixer(makeDataset(SIZE));
+			nm.setReplenishPolicy(std::make_shared<sharedBudget>(REPS, 20));
+		},
+		[&](unsigned int) { nm.ping(returnValues); }, PING_VALUES);
+}
+// Description:
+// * Compares keeping a numMixer pingable by rebuilding it with a new dataset
+// against refilling its countdown from a replenishPolicy.
+
+
+void benchAsync()
+{
+	const unsigned int REPS = 20;
+	const unsigned int MIXERS = 100000;
+	const unsigned int SIZE = 10;
+
+	std::vector<numMixer> mixers;
+	auto setup = [&]() {
+		mixers.assign(MIXERS, numMixer());
+		for (auto& nm : mixers) {
+			nm.setReplenishPolicy(std::make_shared<sharedBudget>(REPS, REPS));
+		}
+	};
+	runBench("ping 100000 numMixers [serial]", REPS, setup,
+		[&](unsigned int) {
+			std::vector<std::vector<int> > results(MIXERS);
+			for (unsigned int i = 0; i < MIXERS; ++i) {
+				results[i].resize(SIZE);
+				mixers[i].ping(results[i]);
+			}
+		}, MIXERS * SIZE);
+	runBench("ping 100000 numMixers [pingAllAsync]", REPS, setup,
+		[&](unsigned int) { pingAllAsync(mixers, SIZE).get(); },
+		MIXERS * SIZE);
+}
+// Description:
+// * Compares a batch ping on the calling thread against one fanned out over
+// the default executor.
+
+
+void benchReservoir()
+{
+	const unsigned int REPS = 200000;
+	const unsigned int SIZE = 30;
+
+	numMixer nm;
+	std::shared_ptr<randomReservoir> reservoir;
+	std::vector<int> returnValues(PING_VALUES);
+	auto setup = [&](bool useReservoir) {
+		return [&, useReservoir]() {
+			nm = numMixer(makeDataset(SIZE));
+			nm.setReplenishPolicy(std::make_shared<sharedBudget>(REPS, 20));
+			reservoir = std::make_shared<randomReservoir>();
+			nm.setReservoir(useReservoir ? reservoir : nullptr);
+		};
+	};
+	auto ping = [&](unsigned int) { nm.ping(returnValues); };
+	auto noIdle = []() {};
+	auto report = [&]() {
+		std::cout << "  reservoir hit rate " << reservoir->hitRate()
+				  << ", " << reservoir->refills() << " refills, "
+				  << double(reservoir->refillNanoseconds()) /
+					 reservoir->refills() << " ns/refill" << std::endl;
+	};
+
+	runLatencyBench("numMixer ping(10) [rng]", REPS, setup(false), ping,
+		noIdle, PING_VALUES);
+	runLatencyBench("numMixer ping(10) [reservoir, inline refill]", REPS,
+		setup(true), ping, noIdle, PING_VALUES);
+	report();
+	runLatencyBench("numMixer ping(10) [reservoir, idle refill]", REPS,
+		setup(true), ping, [&]() { reservoir->refill(); }, PING_VALUES);
+	report();
+	runLatencyBench("numMixer ping(10) [reservoir, background refill]", REPS,
+		[&]() {
+			setup(true)();
+			reservoir->startBackgroundRefill();
+		},
+		ping, noIdle, PING_VALUES);
+	reservoir->stopBackgroundRefill();
+	report();
+}
+// Description:
+// * Compares ping latencies drawing from the rng against drawing from a
+// randomReservoir, refilled on the spot, during idle time, and in the
+// background.
+
+
+int main(int argc, char* argv[])
+{
+	if (argc > 2 || (argc == 2 && std::string(argv[1]) != "--counters")) {
+		std::cerr << "usage: mixerBench [--counters]" << std::endl;
+		return 2;
+	}
+	if (argc == 2) {
+		gCountersOn = openCounters();
+		if (!gCountersOn) {
+			std::cerr << "hardware counters unavailable, timing only"
+					  << std::endl;
+		}
+	}
+
+	std::cout << "== construction ==" << std::endl;
+	benchConstruction();
+	std::cout << std::endl;
+
+	std::cout << "== stacking ==" << std::endl;
+	benchStacking();
+	std::cout << std::endl;
+
+	std::cout << "== churn ==" << std::endl;
+	benchChurn();
+	std::cout << std::endl;
+
+	std::cout << "== bulk construction ==" << std::endl;
+	benchBulkConstruction();
+	std::cout << std::endl;
+
+	std::cout << "== kernels ==" << std::endl;
+	benchKernels();
+	std::cout << std::endl;
+
+	std::cout << "== polyMix ==" << std::endl;
+	benchPolyMix();
+	std::cout << std::endl;
+
+	std::cout << "== scheduler ==" << std::endl;
+	benchScheduler();
+	std::cout << std::endl;
+
+	std::cout << "== results ==" << std::endl;
+	benchResults();
+	std::cout << std::endl;
+
+	std::cout << "== value types ==" << std::endl;
+	benchValueType<std::int16_t>("int16");
+	benchValueType<int>("int32");
+	benchValueType<std::int64_t>("int64");
+	std::cout << std::endl;
+
+	std::cout << "== implicit datasets ==" << std::endl;
+	benchImplicit();
+	std::cout << std::endl;
+
+	std::cout << "== streaming ==" << std::endl;
+	benchStream();
+	std::cout << std::endl;
+
+	std::cout << "== packed datasets ==" << std::endl;
+	benchPacked();
+	std::cout << std::endl;
+
+	std::cout << "== sorted output ==" << std::endl;
+	benchSorted();
+	std::cout << std::endl;
+
+	std::cout << "== pipeline ==" << std::endl;
+	benchPipeline();
+	std::cout << std::endl;
+
+	std::cout << "== lazy pings ==" << std::endl;
+	benchLazy();
+	std::cout << std::endl;
+
+	std::cout << "== shared memory ==" << std::endl;
+	benchShared();
+	std::cout << std::endl;
+
+	std::cout << "== sharding ==" << std::endl;
+	benchSharded();
+	std::cout << std::endl;
+
+	std::cout << "== NUMA placement ==" << std::endl;
+	benchNuma();
+	std::cout << std::endl;
+
+	std::cout << "== replenishment ==" << std::endl;
+	benchReplenish();
+	std::cout << std::endl;
+
+	std::cout << "== async ==" << std::endl;
+	benchAsync();
+	std::cout << std::endl;
+
+	std::cout << "== reservoir ==" << std::endl;
+	benchReservoir();
+
+	return 0;
+}
+// Description:
+// * Runs every benchmark group and prints the results to stdout.
+// * Exits with 2 on bad usage.
@@ -0,0 +1,576 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: mixerStats.cpp
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// DESCRIPTION:
+// * Statistical quality harness for the mixer classes. Streams samples from
+// every output mode and checks their distribution against the one the mode
+// should produce, so a faster sampling path is only accepted once it passes.
+// * Every mode is checked with a chi-square goodness of fit test over its
+// values, a Kolmogorov-Smirnov test over their cumulative distribution, and
+// the ordering its pings promise (alternating parity, evens before odds, no
+// duplicates, ascending).
+// * Prints the samples/s achieved per mode.
+// * Usage:
+//   mixerStats [samples] [threads]  streams <samples> values per mode
+//                                   (default 10^9), on <threads> threads
+//                                   (default one per hardware thread)
+
+// ASSUMPTIONS:
+// * Built with optimizations enabled (see compilestats.ps1).
+// * Exits with 0 if every mode passes, 1 if any fails, 2 on bad usage.
+// * A test fails below a p-value of 10^-6, so a correct build fails by chance
+// about once in 30000 runs of every mode.
+// * Every thread samples mixers of its own, drawing from rngs of its own (see
+// mixSeed.h), into a histogram of its own. Histograms are merged at the end.
+// * Expected distributions follow from how values are drawn: MIX draws every
+// dataset entry with equal odds, EVEN and ODD every entry of their parity.
+// * multiMix pings cluster on the dataset of the numMixer pinged, so they are
+// not independent draws from 2-100. Their expected counts are instead summed
+// ping by ping, from the dataset of the numMixer that returned them, less
+// primes for "Mix".
+// * Pings that drop duplicates (dubMix ctl 4) or primes (multiMix "Mix")
+// return fewer values, and every value returned counts as a sample. Dropping
+// duplicates makes counts less dispersed than independent draws, which only
+// makes the tests more lenient.
+// * The Kolmogorov-Smirnov p-value is computed as for a continuous
+// distribution, which is conservative for the discrete values of the mixers.
+
+
+#include <algorithm>  // max, min, sort
+#include <chrono>  // steady_clock
+#include <cmath>  // exp, log, sqrt, fabs, lgamma
+#include <cstdint>  // uint64_t
+#include <cstdlib>  // strtoull
+#include <functional>  // function
+#include <iomanip>  // setw, setprecision
+#include <iostream>  // cout, cerr
+#include <limits>  // numeric_limits
+#include <memory>  // make_shared
+#include <random>  // mt19937, uniform_int_distribution
+#include <string>  // string
+#include <thread>  // thread, hardware_concurrency
+#include <vector>  // vector
+
+
+#include "../include/dubMix.h"
+#include "../include/mixValue.h"
+#include "../include/multiMix.h"
+#include "../include/numMixer.h"
+#include "../include/replenishPolicy.h"
+
+
+static const unsigned int BINS = 128;
+// Values 0-127 are binned, every mode draws from 1-100.
+
+static const double FAIL_P = 1e-6;
+// p-value below which a test fails.
+
+
+struct modeStats
+{
+	std::vector<std::uint64_t> counts;
+	std::uint64_t samples;
+	std::uint64_t outOfRange;
+	std::uint64_t malformed;
+	std::vector<double> expected;
+
+	modeStats():
+		counts(BINS, 0),
+		samples(0),
+		outOfRange(0),
+		malformed(0),
+		expected(BINS, 0.0)
+	{
+	}
+};
+// Description:
+// * Histogram of a mode's values, the amount of values sampled, of values
+// outside the bins, and of pings breaking the ordering they promise.
+// * "expected" holds the expected count of every bin, summed by the sampler
+// for modes without a fixed distribution.
+
+
+struct mode
+{
+	std::string name;
+	std::vector<double> expected;
+	std::function<void(modeStats&, std::uint64_t)> run;
+};
+// Description:
+// * An output mode: its name, the expected probability of every bin (empty if
+// the sampler sums expected counts itself), and a sampler that streams at
+// least the given amount of values into a modeStats.
+
+
+void record(modeStats& stats, const int* values, std::size_t count)
+{
+	for (std::size_t i = 0; i < count; ++i) {
+		if (values[i] >= 0 && values[i] < static_cast<int>(BINS)) {
+			++stats.counts[values[i]];
+		} else {
+			++stats.outOfRange;
+		}
+	}
+	stats.samples += count;
+}
+// Description:
+// * Adds "count" values to the histogram of "stats".
+
+
+bool ascending(const int* values, std::size_t count, bool strict)
+{
+	for (std::size_t i = 1; i < count; ++i) {
+		if (values[i] < values[i - 1] ||
+			(strict && values[i] == values[i - 1])) {
+			return false;
+		}
+	}
+	return true;
+}
+// Description:
+// * Returns whether "values" are in ascending order, strictly if "strict".
+
+
+bool anyValue(int)
+{
+	return true;
+}
+
+
+bool isEvenValue(int v)
+{
+	return !(v & 1);
+}
+
+
+bool isOddValue(int v)
+{
+	return (v & 1);
+}
+
+
+bool isCompositeValue(int v)
+{
+	return !mixValueTraits<int>::isPrime(v);
+}
+// Description:
+// * Value filters, selecting the values a mode can return.
+
+
+std::vector<double> uniformOver(int first, int last, bool (*keep)(int))
+{
+	std::vector<double> expected(BINS, 0.0);
+	double total = 0;
+	for (int v = first; v <= last; ++v) {
+		if (keep(v)) {
+			expected[v] = 1.0;
+			++total;
+		}
+	}
+	for (double& p : expected) {
+		p /= total;
+	}
+	return expected;
+}
+// Description:
+// * Returns the uniform distribution over the values of [first, last] that
+// "keep" accepts.
+
+
+std::vector<double> datasetDistribution(const std::vector<int>& dataset,
+										bool (*keep)(int))
+{
+	std::vector<double> expected(BINS, 0.0);
+	double total = 0;
+	for (int val : dataset) {
+		if (keep(val)) {
+			++expected[val];
+			++total;
+		}
+	}
+	for (double& p : expected) {
+		p = total ? p / total : 0.0;
+	}
+	return expected;
+}
+// Description:
+// * Returns the distribution of draws from the entries of "dataset", kept if
+// "keep" accepts them.
+
+
+double gammaQ(double a, double x)
+{
+	// regularized upper incomplete gamma function, by series below a + 1 and
+	// by continued fraction above (see Numerical Recipes, 6.2)
+	const int ITERATIONS = 1000;
+	const double EPSILON = 1e-15;
+	const double TINY = 1e-300;
+	if (x <= 0) {
+		return 1.0;
+	}
+	const double LOG_PREFIX = a * std::log(x) - x - std::lgamma(a);
+	if (x < a + 1) {
+		double term = 1.0 / a;
+		double sum = term;
+		for (int n = 1; n < ITERATIONS; ++n) {
+			term *= x / (a + n);
+			sum += term;
+			if (std::fabs(term) < std::fabs(sum) * EPSILON) {
+				break;
+			}
+		}
+		return 1.0 - sum * std::exp(LOG_PREFIX);
+	}
+	double b = x + 1 - a;
+	double c = 1 / TINY;
+	double d = 1 / b;
+	double h = d;
+	for (int n = 1; n < ITERATIONS; ++n) {
+		const double AN = -n * (n - a);
+		b += 2;
+		d = AN * d + b;
+		d = (std::fabs(d) < TINY) ? TINY : d;
+		c = b + AN / c;
+		c = (std::fabs(c) < TINY) ? TINY : c;
+		d = 1 / d;
+		const double DELTA = d * c;
+		h *= DELTA;
+		if (std::fabs(DELTA - 1) < EPSILON) {
+			break;
+		}
+	}
+	return std::exp(LOG_PREFIX) * h;
+}
+// Description:
+// * Returns Q(a, x), the probability that a chi-square variable with 2 * "a"
+// degrees of freedom exceeds 2 * "x".
+
+
+double chiSquareP(const modeStats& stats)
+{
+	double chi2 = 0;
+	int bins = 0;
+	for (unsigned int v = 0; v < BINS; ++v) {
+		const double E = stats.expected[v];
+		if (E == 0) {
+			if (stats.counts[v]) {
+				// a value the mode can not produce
+				return 0.0;
+			}
+			continue;
+		}
+		const double DIFF = stats.counts[v] - E;
+		chi2 += DIFF * DIFF / E;
+		++bins;
+	}
+	return (bins > 1) ? gammaQ((bins - 1) / 2.0, chi2 / 2) : 1.0;
+}
+// Description:
+// * Returns the p-value of a chi-square goodness of fit test of the histogram
+// of "stats" against its expected counts.
+
+
+double kolmogorovSmirnovP(const modeStats& stats)
+{
+	double d = 0;
+	double observed = 0;
+	double cumulative = 0;
+	for (unsigned int v = 0; v < BINS; ++v) {
+		observed += static_cast<double>(stats.counts[v]) / stats.samples;
+		cumulative += stats.expected[v] / stats.samples;
+		d = std::max(d, std::fabs(observed - cumulative));
+	}
+
+	// Kolmogorov distribution, Q(l) = 2 sum (-1)^(j - 1) exp(-2 j^2 l^2)
+	const double LAMBDA = std::sqrt(static_cast<double>(stats.samples)) * d;
+	if (LAMBDA < 0.2) {
+		return 1.0;
+	}
+	double p = 0;
+	for (int j = 1; j <= 100; ++j) {
+		const double TERM = std::exp(-2.0 * j * j * LAMBDA * LAMBDA);
+		p += (j % 2 ? 2 : -2) * TERM;
+		if (TERM < 1e-17) {
+			break;
+		}
+	}
+	return std::min(std::max(p, 0.0), 1.0);
+}
+// Description:
+// * Returns the p-value of a Kolmogorov-Smirnov test of the cumulative
+// distribution of "stats" against that of its expected counts.
+
+
+std::shared_ptr<replenishPolicy> endlessBudget()
+{
+	return std::make_shared<sharedBudget>(
+		std::numeric_limits<long long>::max() / 2, 1 << 20);
+}
+// Description:
+// * Returns a replenishPolicy that keeps a numMixer active for good.
+
+
+std::vector<int> statsDataset()
+{
+	const unsigned int SIZE = 30;
+	std::mt19937 eng(7);
+	std::uniform_int_distribution<int> distr(2, 100);
+	std::vector<int> dataset(SIZE);
+	for (int& val : dataset) {
+		val = distr(eng);
+	}
+	return dataset;
+}
+// Description:
+// * Returns the dataset numMixer modes are sampled from: 30 values 2-100,
+// fixed, with repeats, so the expected distribution is not uniform.
+
+
+std::function<void(modeStats&, std::uint64_t)>
+numMixerSampler(numMixer::OutputController state, int kind)
+{
+	return [state, kind](modeStats& stats, std::uint64_t samples) {
+		const unsigned int BATCH = 64;
+		numMixer nm = (kind == 2) ? numMixer(numMixer::range{ 1, 100, 1 })
+								  : numMixer(statsDataset());
+		if (kind == 1) {
+			nm.pack();
+		}
+		nm.setControllerState(state);
+		nm.setReplenishPolicy(endlessBudget());
+		std::vector<int> values(BATCH);
+		while (stats.samples < samples) {
+			nm.ping(values.data(), BATCH);
+			record(stats, values.data(), BATCH);
+		}
+	};
+}
+// Description:
+// * Returns a sampler of a numMixer in state "state", over statsDataset() as
+// a vector (kind 0) or packed (kind 1), or over the implicit range 1-100
+// (kind 2). Pings a batch at a time, which takes the bulk path of packed
+// datasets.
+
+
+std::function<void(modeStats&, std::uint64_t)> dubMixSampler(int ctl,
+															  bool sorted)
+{
+	return [ctl, sorted](modeStats& stats, std::uint64_t samples) {
+		dubMix dm;
+		dm.setCtl(ctl);
+		dm.setSortedOutput(sorted);
+		while (stats.samples < samples) {
+			// fresh numMixers once the countdowns run out
+			if (!dm.x().isActive() || !dm.z().isActive()) {
+				dm = dubMix();
+				dm.setCtl(ctl);
+				dm.setSortedOutput(sorted);
+			}
+			dubMix::mixResult result = dm.ping();
+			const int* values = result.data();
+			const std::size_t SIZE = result.size();
+			bool wellFormed = true;
+			if (sorted) {
+				wellFormed = ascending(values, SIZE, ctl == 4);
+			} else if (ctl == 3) {
+				for (std::size_t i = 0; i < SIZE; ++i) {
+					wellFormed &= ((values[i] & 1) == static_cast<int>(i % 2));
+				}
+			} else if (ctl == 4) {
+				std::size_t i = 0;
+				while (i < SIZE && !(values[i] & 1)) {
+					++i;
+				}
+				while (i < SIZE && (values[i] & 1)) {
+					++i;
+				}
+				std::vector<int> sortedValues(values, values + SIZE);
+				std::sort(sortedValues.begin(), sortedValues.end());
+				wellFormed = (i == SIZE &&
+							  ascending(sortedValues.data(), SIZE, true));
+			}
+			if (!wellFormed) {
+				++stats.malformed;
+			}
+			record(stats, values, SIZE);
+		}
+	};
+}
+// Description:
+// * Returns a sampler of a dubMix with ctl "ctl", in sorted output mode if
+// "sorted". Checks that ctl 3 alternates even and odd values, and that ctl 4
+// puts evens before odds, without duplicates.
+
+
+std::function<void(modeStats&, std::uint64_t)>
+multiMixSampler(unsigned int state, bool packedSorted)
+{
+	return [state, packedSorted](modeStats& stats, std::uint64_t samples) {
+		multiMix mm;
+		mm.setPackedDatasets(packedSorted);
+		mm.setSortedOutput(packedSorted);
+		// the top of the stack is at index "state", so it pings in that state
+		mm.addNumMixers(state + 1);
+		bool (*keep)(int) = (state == 0) ? isCompositeValue :
+							(state == 1) ? isEvenValue : isOddValue;
+		std::vector<double> distribution;
+		while (stats.samples < samples) {
+			const numMixer& rTop = mm.numMixerStack().back();
+			if (!rTop.isActive() ||
+				(state == 1 && !rTop.evenValid()) ||
+				(state == 2 && !rTop.oddValid())) {
+				// replace the top with a fresh numMixer, pinging it would fail
+				mm.removeNumMixers(1);
+				mm.addNumMixers(1);
+				distribution.clear();
+				continue;
+			}
+			if (distribution.empty()) {
+				distribution = datasetDistribution(rTop.dataset(), keep);
+			}
+			multiMix::mixResult result = mm.ping();
+			for (unsigned int v = 0; v < BINS; ++v) {
+				stats.expected[v] += result.size() * distribution[v];
+			}
+			if (packedSorted && !ascending(result.data(), result.size(),
+										   false)) {
+				++stats.malformed;
+			}
+			record(stats, result.data(), result.size());
+		}
+	};
+}
+// Description:
+// * Returns a sampler of a multiMix whose top numMixer is in state "state"
+// (0 "Mix", 1 "Even", 2 "Odd"), with packed datasets and sorted output if
+// "packedSorted". numMixers are replaced as they run out, or if they hold no
+// values of the state's parity. Sums the expected counts of every ping from
+// the dataset of the numMixer pinged.
+
+
+std::vector<mode> modes()
+{
+	const std::vector<int> DATASET = statsDataset();
+	return {
+		{ "numMixer MIX", datasetDistribution(DATASET, anyValue),
+		  numMixerSampler(numMixer::MIX, 0) },
+		{ "numMixer EVEN", datasetDistribution(DATASET, isEvenValue),
+		  numMixerSampler(numMixer::EVEN, 0) },
+		{ "numMixer ODD", datasetDistribution(DATASET, isOddValue),
+		  numMixerSampler(numMixer::ODD, 0) },
+		{ "numMixer MIX [packed]", datasetDistribution(DATASET, anyValue),
+		  numMixerSampler(numMixer::MIX, 1) },
+		{ "numMixer EVEN [packed]", datasetDistribution(DATASET, isEvenValue),
+		  numMixerSampler(numMixer::EVEN, 1) },
+		{ "numMixer EVEN [implicit range]", uniformOver(1, 100, isEvenValue),
+		  numMixerSampler(numMixer::EVEN, 2) },
+		{ "numMixer ODD [implicit range]", uniformOver(1, 100, isOddValue),
+		  numMixerSampler(numMixer::ODD, 2) },
+		{ "dubMix ctl1", uniformOver(1, 100, isEvenValue),
+		  dubMixSampler(1, false) },
+		{ "dubMix ctl2", uniformOver(1, 100, isOddValue),
+		  dubMixSampler(2, false) },
+		{ "dubMix ctl3", uniformOver(1, 100, anyValue),
+		  dubMixSampler(3, false) },
+		{ "dubMix ctl4", uniformOver(1, 100, anyValue),
+		  dubMixSampler(4, false) },
+		{ "dubMix ctl4 [sorted]", uniformOver(1, 100, anyValue),
+		  dubMixSampler(4, true) },
+		{ "multiMix Mix [prime purge]", {}, multiMixSampler(0, false) },
+		{ "multiMix Even", {}, multiMixSampler(1, false) },
+		{ "multiMix Odd", {}, multiMixSampler(2, false) },
+		{ "multiMix Mix [packed, sorted]", {}, multiMixSampler(0, true) },
+	};
+}
+// Description:
+// * Returns every mode the harness checks, with its expected distribution.
+
+
+bool runMode(const mode& rMode, std::uint64_t samples, unsigned int threadCount)
+{
+	std::vector<modeStats> stats(threadCount);
+	std::vector<std::thread> threads;
+	const std::uint64_t PER_THREAD = (samples + threadCount - 1) / threadCount;
+	auto start = std::chrono::steady_clock::now();
+	for (unsigned int t = 0; t < threadCount; ++t) {
+		threads.emplace_back([&, t]() { rMode.run(stats[t], PER_THREAD); });
+	}
+	for (std::thread& rThread : threads) {
+		rThread.join();
+	}
+	auto stop = std::chrono::steady_clock::now();
+
+	modeStats total;
+	for (const modeStats& rStats : stats) {
+		for (unsigned int v = 0; v < BINS; ++v) {
+			total.counts[v] += rStats.counts[v];
+		}
+		total.samples += rStats.samples;
+		total.outOfRange += rStats.outOfRange;
+		total.malformed += rStats.malformed;
+		for (unsigned int v = 0; v < BINS; ++v) {
+			total.expected[v] += rStats.expected[v];
+		}
+	}
+	if (!rMode.expected.empty()) {
+		for (unsigned int v = 0; v < BINS; ++v) {
+			total.expected[v] = rMode.expected[v] * total.samples;
+		}
+	}
+
+	const double SECONDS = std::chrono::duration<double>(stop - start).count();
+	const double CHI2_P = chiSquareP(total);
+	const double KS_P = kolmogorovSmirnovP(total);
+	const bool PASSED = (CHI2_P >= FAIL_P && KS_P >= FAIL_P &&
+						 !total.outOfRange && !total.malformed);
+	std::cout << std::left << std::setw(34) << rMode.name << std::right
+			  << std::setw(10) << std::setprecision(3) << std::scientific
+			  << double(total.samples) << " samples"
+			  << std::setw(10) << total.samples / SECONDS << " /s"
+			  << std::fixed << std::setprecision(4)
+			  << "  chi2 p " << CHI2_P << "  KS p " << KS_P;
+	if (total.outOfRange || total.malformed) {
+		std::cout << "  " << total.outOfRange << " out of range, "
+				  << total.malformed << " malformed";
+	}
+	std::cout << (PASSED ? "  PASS" : "  FAIL") << std::endl;
+	return PASSED;
+}
+// Description:
+// * Streams "samples" values of "rMode" on "threadCount" threads, tests them
+// and prints the result. Returns whether the mode passed.
+
+
+int main(int argc, char* argv[])
+{
+	std::uint64_t samples = 1000000000ULL;
+	unsigned int threadCount = std::thread::hardware_concurrency();
+	if (argc > 3) {
+		std::cerr << "usage: mixerStats [samples] [threads]" << std::endl;
+		return 2;
+	}
+	if (argc > 1) {
+		samples = std::strtoull(argv[1], 0, 10);
+	}
+	if (argc > 2) {
+		threadCount = std::strtoul(argv[2], 0, 10);
+	}
+	if (samples == 0 || (argc > 2 && threadCount == 0)) {
+		std::cerr << "usage: mixerStats [samples] [threads]" << std::endl;
+		return 2;
+	}
+	threadCount = std::max(threadCount, 1u);
+
+	std::cout << "== mixer statistics, " << threadCount << " threads =="
+			  << std::endl;
+	bool passed = true;
+	for (const mode& rMode : modes()) {
+		passed &= runMode(rMode, samples, threadCount);
+	}
+	return passed ? 0 : 1;
+}
+// Description:
+// * Runs every mode, and exits with 0 if all of them pass.
\ No newline at end of file
@@ -0,0 +1 @@
+& g++ -std=c++20 -pedantic -pthread ./src/*.cpp -o ./bin/main20
\ No newline at end of file
@@ -1,3 +1,3 @@
-& g++ -std=c++11 -pedantic ./src/*.cpp -o ./bin/main
+& g++ -std=c++11 -pedantic -pthread ./src/*.cpp -o ./bin/main
 
 & ./bin/main.exe
\ No newline at end of file
@@ -0,0 +1 @@
+& g++ -std=c++11 -pedantic -pthread -O2 ./tools/mixReplay.cpp (Get-ChildItem ./src/*.cpp -Exclude main.cpp).FullName -o ./bin/mixReplay
@@ -0,0 +1,3 @@
+& g++ -std=c++11 -pedantic -pthread -O2 ./bench/mixerStats.cpp (Get-ChildItem ./src/*.cpp -Exclude main.cpp).FullName -o ./bin/mixerStats
+
+& ./bin/mixerStats.exe
\ No newline at end of file
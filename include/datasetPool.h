@@ -0,0 +1,166 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: datasetPool.h
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Class Invariant:
+// * The pool begins empty, with a capacity of 0.
+// * The pool never holds more than "capacity" buffers.
+// * Buffers held by the pool keep their allocation, so handing them out again
+// does not touch the heap.
+
+// Interface Invariant:
+// * acquire() hands out a buffer of the requested size, recycled if one is
+// available.
+// * release() takes a buffer back, keeping it if there is room, else freeing
+// it.
+// * reserve() raises the capacity and preallocates buffers, so a steady state
+// of acquire/release pairs performs no heap traffic.
+
+// DESCRIPTION:
+// * datasetPool recycles dataset buffers for numMixer objects, so clients that
+// repeatedly create and destroy numMixers (i.e. multiMix add/remove churn) can
+// reuse allocations instead of going to the general-purpose heap.
+
+// ASSUMPTIONS:
+// * With a capacity of 0 (the default) the pool behaves like plain allocation:
+// acquire() allocates and release() frees.
+// * Copying a pool copies its capacity, but not the buffers it holds.
+// * The pool is not thread-safe.
+// * basicDatasetPool<T> pools datasets of values of type T, and is
+// instantiated for the value types of the mixers (see datasetPool.cpp).
+// datasetPool pools int datasets.
+
+
+#ifndef datasetPool_INCLUDED
+#define datasetPool_INCLUDED
+
+
+#include <vector>  // vector
+
+
+template <typename T>
+class basicDatasetPool
+{
+	public:
+		// Constructors
+
+		explicit basicDatasetPool(unsigned int capacity = 0);
+		// Description:
+		// * Creates an empty pool that holds at most "capacity" buffers.
+		//
+		// Postconditions:
+		// * The pool holds no buffers.
+
+		basicDatasetPool(const basicDatasetPool& obj);  // 1
+		basicDatasetPool(basicDatasetPool&& obj) = default;  // 2
+		basicDatasetPool& operator=(const basicDatasetPool& obj);  // 3
+		basicDatasetPool& operator=(basicDatasetPool&& obj) = default;  // 4
+		// Description (1-4):
+		// * (1, 3) copy the capacity only, the copy starts with no buffers.
+		// * (2, 4) take over the buffers of "obj".
+
+
+		// Destructors
+
+		~basicDatasetPool();
+		// Description:
+		// * Placeholder, no-op
+
+
+		// Functionality
+
+		std::vector<T> acquire(unsigned int size);
+		// Description:
+		// * Returns a buffer of size "size".
+		// * A pooled buffer is reused if one is available, otherwise a new
+		// buffer is allocated.
+		// * The contents of the buffer are unspecified.
+
+		void release(std::vector<T>&& buffer);
+		// Description:
+		// * Returns "buffer" to the pool.
+		// * If the pool is full, "buffer" is freed instead.
+		//
+		// Postconditions:
+		// * "buffer" is empty.
+
+		void reserve(unsigned int count, unsigned int size);
+		// Description:
+		// * Raises the capacity to at least "count", and preallocates buffers
+		// of size "size" until the pool holds "count" of them.
+		//
+		// Postconditions:
+		// * The pool holds at least "count" buffers.
+
+
+		// Accessors
+
+		unsigned int capacity() const;
+		// Description:
+		// * Returns the most buffers the pool will hold.
+
+		unsigned int available() const;
+		// Description:
+		// * Returns the amount of buffers currently held by the pool.
+
+		unsigned long hits() const;
+		// Description:
+		// * Returns how many acquire() calls were served by a pooled buffer.
+
+		unsigned long misses() const;
+		// Description:
+		// * Returns how many acquire() calls had to allocate.
+
+
+	private:
+		// Members
+
+		unsigned int _capacity;
+		// The most buffers the pool will hold.
+
+		unsigned long _hits;
+		// acquire() calls served by a pooled buffer.
+
+		unsigned long _misses;
+		// acquire() calls that had to allocate.
+
+		std::vector<std::vector<T> > _buffers;
+		// Buffers waiting to be reused.
+};
+
+
+typedef basicDatasetPool<int> datasetPool;
+// Pool of the int mixers.
+
+
+template <typename T>
+inline unsigned int basicDatasetPool<T>::capacity() const
+{
+	return _capacity;
+}
+
+
+template <typename T>
+inline unsigned int basicDatasetPool<T>::available() const
+{
+	return _buffers.size();
+}
+
+
+template <typename T>
+inline unsigned long basicDatasetPool<T>::hits() const
+{
+	return _hits;
+}
+
+
+template <typename T>
+inline unsigned long basicDatasetPool<T>::misses() const
+{
+	return _misses;
+}
+
+
+#endif
@@ -18,6 +18,8 @@
 // * ctl == 2 returns odd integers.
 // * ctl == 3 returns alternating even and odd integers.
 // * ctl == 4 returns even followed by odd integers, without duplicates.
+// * In sorted output mode, every ctl returns its integers in ascending order
+// instead.
 
 // DESCRIPTION:
 // * dubMix mixes values from two numMixer objects and returns them depending on
@@ -37,30 +39,73 @@
 // (i.e. [0] = x, [1] = z, [2] = x, ... ).
 // * If ctl is set to 4, values from "x" are followed by values from "z", within
 // the same return array. Duplicates are removed.
+// * The client can turn on sorted output mode through a public mutator. Pings
+// then return the same values, sorted in ascending order by a counting sort
+// over their range (see mixKernels.h), so ctl 3 no longer alternates and ctl
+// 4 no longer puts even values first. ctl 4 removes duplicates in the same
+// pass.
+// * The client can set a mixPipeline (see mixPipeline.h) through a public
+// mutator, which every ping is run through before it is sorted. Filters may
+// leave ctl 3 no longer alternating. ctl 4 runs it with duplicates removed,
+// as mixPipeline::duplicatePurge() does, in the same pass that joins the
+// values of "x" and "z".
+// * lazyPing() returns a view of a ping (see pingView.h), drawn in blocks as
+// it is read. ctl 1-3 draw from views of "x" and "z", so "x" and "z" consume
+// their countdown when the first block is drawn, and each block is run
+// through the pipeline as it was when the view was made. ctl 4, sorted
+// output and pipelines removing duplicates need the whole ping before the
+// first value is known, so their view pings in full at the first block.
+// * Where a ping of "x" or "z" fails, ping() returns zeros in its place, but
+// a view ends.
 // * Comparison (==) operators are supported.
-// * Comparison is performed on all members.
+// * Comparison is performed on all members but the pipeline, as functions can
+// not be compared.
+// * A fingerprint of all members is available in O(1), built from the
+// fingerprints of "_x" and "_z".
 // * Relational (<) operators are supported.
 // * Relations are assed on _x and _z.
 // * Addition (+) operators are supported.
 // * Addition is performed on _x and _z.
+// * basicDubMix<T> mixes two numMixers of values of type T (see numMixer.h).
+// dubMix mixes ints, dubMix16 and dubMix64 16-bit and 64-bit values. The
+// value types are instantiated at the bottom of dubMix.cpp.
 
 
 #ifndef dubMix_INCLUDED
 #define dubMix_INCLUDED
 
 
+#include <cstddef>  // size_t
+#include <cstdint>  // int16_t, int64_t
+#include <functional>  // hash
 #include <vector>  // vector
 
 
+#include "../include/mixHash.h"
+#include "../include/mixPipeline.h"
+#include "../include/mixResult.h"
 #include "../include/numMixer.h"
+#include "../include/pingView.h"
 
 
-class dubMix
+template <typename T>
+class basicDubMix
 {
 	public:
+		// Types
+
+		typedef T value_type;
+		typedef basicNumMixer<T> numMixer;
+		typedef basicMixResult<T> mixResult;
+		typedef basicMixPipeline<T> mixPipeline;
+		typedef basicPingView<T> pingView;
+		// Values, numMixers, results, pipelines and ping views of the
+		// dubMix's value type.
+
+
 		// Constructos
 
-		dubMix();
+		basicDubMix();
 		// Description:
 		// * Creates two numMixer objects, "_x" and "_z".
 		// * "_x" is set to output even numbers.
@@ -76,16 +121,26 @@ class dubMix
 		// * "_z" is set to output odd values.
 		// * "_ctl" is set to 3.
 
-		~dubMix();
+		basicDubMix(const basicDubMix& obj) = default;  // 1
+		basicDubMix(basicDubMix&& obj) = default;  // 2
+		basicDubMix& operator=(const basicDubMix& obj) = default;  // 3
+		basicDubMix& operator=(basicDubMix&& obj) = default;  // 4
+		// Description (1-4):
+		// * Copies/moves "_ctl", "_x", "_z" and the pipeline.
+
+
+		// Destructors
+
+		~basicDubMix();
 		// Description:
 		// * Placeholder, no-op
 
 
 		// Functionality
 
-		std::vector<int> ping();
+		mixResult ping();
 		// Description:
-		// * Pings the numMixer objects, "_x" and "_z", and returns a vector,
+		// * Pings the numMixer objects, "_x" and "_z", and returns a result,
 		// whose values depend on the state of "_ctl".
 		// * If "ctl" is 1, returns 10 values from "_x".
 		// * If "ctl" is 2, returns 10 values from "_z".
@@ -95,11 +150,36 @@ class dubMix
 		// * If "_ctl" is 4, returns values from "_x", followed by values from
 		// "_z".
 		// * Duplicates are removed.
-		// * The total count of values is <= 20.
+		// * The total count of values is <= 20, so the result is held inline
+		// and returning it does not allocate (see mixResult.h).
+		// * In sorted output mode, the values are in ascending order.
 		// 
 		// Preconditions:
 		// * "_ctl" must be set to a valid value.
 
+		mixResult ping(unsigned int size);
+		// Description:
+		// * Same as ping(), but requests "size" values from each numMixer
+		// instead of 10.
+		// * ping() is equivalent to ping(10).
+		//
+		// Preconditions:
+		// * "_ctl" must be set to a valid value.
+		// * "size" should be > 0.
+
+		pingView lazyPing(unsigned int size);
+		// Description:
+		// * Returns a view of the values ping(size) would return, drawn in
+		// blocks as they are read.
+		// * ctl 4, sorted output and pipelines removing duplicates ping in
+		// full when the first block is drawn.
+		// * The view is empty if "_ctl" is not valid.
+		//
+		// Preconditions:
+		// * Same as ping(size), when the first block is drawn.
+		// * The dubMix must outlive the view, and not be moved while it is
+		// read.
+
 
 		// Accessors
 
@@ -115,6 +195,20 @@ class dubMix
 		// Description:
 		// * Returns z.
 
+		bool sortedOutput() const;
+		// Description:
+		// * Returns whether pings return their values sorted.
+
+		const mixPipeline& pipeline() const;
+		// Description:
+		// * Returns the pipeline pings are run through, empty by default.
+
+		std::size_t hash() const;
+		// Description:
+		// * Returns a fingerprint of "_ctl", "_sortedOutput", "_x" and "_z",
+		// in O(1).
+		// * Equal dubMixes have equal fingerprints.
+
 
 		// Mutators
 
@@ -129,25 +223,50 @@ class dubMix
 		// Postconditions:
 		// * "_ctl" is set to the passed value.
 
+		void setSortedOutput(bool sorted);
+		// Description:
+		// * Sets whether pings return their values sorted in ascending order.
+
+		void setPipeline(mixPipeline pipeline);
+		// Description:
+		// * Runs pings through "pipeline" from now on. ctl 4 also removes
+		// duplicates, whether "pipeline" does or not.
+
 		
 		// Comparison Operators
 
-		friend bool operator==(const dubMix& lhs, const dubMix& rhs);  // 1
-		friend bool operator!=(const dubMix& lhs, const dubMix& rhs);  // 2
+		template <typename U>
+		friend bool operator==(const basicDubMix<U>& lhs,
+							   const basicDubMix<U>& rhs);  // 1
+		template <typename U>
+		friend bool operator!=(const basicDubMix<U>& lhs,
+							   const basicDubMix<U>& rhs);  // 2
 		// Description (1-2):
-		// * Checks if _ctl, _x, and _z are the same.
-
-		friend bool operator<(const dubMix& lhs, const dubMix& rhs);  // 3
-		friend bool operator>(const dubMix& lhs, const dubMix& rhs);  // 4
-		friend bool operator<=(const dubMix& lhs, const dubMix& rhs);  // 5
-		friend bool operator>=(const dubMix& lhs, const dubMix& rhs);  // 6
+		// * Checks if _ctl, _sortedOutput, _x, and _z are the same.
+		// * _x and _z are compared by fingerprint first, so datasets are only
+		// compared element by element if they are likely equal.
+
+		template <typename U>
+		friend bool operator<(const basicDubMix<U>& lhs,
+							  const basicDubMix<U>& rhs);  // 3
+		template <typename U>
+		friend bool operator>(const basicDubMix<U>& lhs,
+							  const basicDubMix<U>& rhs);  // 4
+		template <typename U>
+		friend bool operator<=(const basicDubMix<U>& lhs,
+							   const basicDubMix<U>& rhs);  // 5
+		template <typename U>
+		friend bool operator>=(const basicDubMix<U>& lhs,
+							   const basicDubMix<U>& rhs);  // 6
 		// Description (3-6):
 		// * Performs comparison on lhs._x, lhs._z and rhs._x, rhs._z.
 
 		// Arithmetic Operators
 
-		friend dubMix operator+(dubMix lhs, const dubMix& rhs);  // 1
-		dubMix& operator+=(const dubMix& obj);  // 2
+		template <typename U>
+		friend basicDubMix<U> operator+(basicDubMix<U> lhs,
+										const basicDubMix<U>& rhs);  // 1
+		basicDubMix& operator+=(const basicDubMix& obj);  // 2
 		// Description (1-2):
 		// * Adds rhs._x, rhs._z to lhs._x, lhs._z respectively.
 		// 
@@ -158,43 +277,39 @@ class dubMix
 	private:
 		// Utility
 
-		void purgeDuplicates(std::vector<int>& arr);
-		// Description:
-		// * Removes duplicate values from the passed vector.
-		// * Duplicate values are moved to the end of the vector, decrementing
-		// "newSize" each time.
-		// * Once the vector has been parsed, it is resized to "newSize",
-		// discarding duplicate values at the end.
-		// 
-		// Preconditions:
-		// * "arr" should be an vector of size >= 2.
-
-		std::vector<int> ctl1(unsigned int size);
+		mixResult ctl1(unsigned int size);
 		// Description:
 		// * Returns even values from "_x" in the case "_ctl" is set to 1.
 		//
 		// Preconditions:
 		// * "size" should be > 0.
 
-		std::vector<int> ctl2(unsigned int size);
+		mixResult ctl2(unsigned int size);
 		// Description:
 		// * Returns odd values from "_z" in the case "_ctl" is set to 2.
 		//
 		// Preconditions:
 		// * "size" should be > 0.
 
-		std::vector<int> ctl3(unsigned int size);
+		mixResult ctl3(unsigned int size);
 		// Description:
 		// * Returns altenating even and odd values from "_x" and "_z" in the
 		// case "_ctl" is set to 3.
+		// * Values are merged with the interleave() kernel.
 		//
 		// Preconditions:
 		// * "size" should be > 1.
 
-		std::vector<int> ctl4(unsigned int size);
+		mixResult ctl4(unsigned int size);
 		// Description:
 		// * Returns even vlues from "_x", followed by odd values from "_z" in
 		// the case "_ctl" is set to 4.
+		// * "_x" and "_z" are pinged straight into the two halves of the
+		// output, which the pipeline then purges of duplicates and compacts,
+		// in one pass.
+		// * In sorted output mode, both halves are sorted and purged of
+		// duplicates together, by sortUniqueValues(). "_x" and "_z" hold
+		// values of different parities, so no value is in both.
 		//
 		// Preconditions:
 		// * "size" should be > 1.
@@ -205,6 +320,12 @@ class dubMix
 		int _ctl;
 		// Used to determine the dubMix's output.
 
+		bool _sortedOutput;
+		// Whether pings return their values sorted.
+
+		mixPipeline _pipeline;
+		// Pipeline pings are run through.
+
 		numMixer _x;
 		// Contains a dataset of even values.
 
@@ -213,71 +334,120 @@ class dubMix
 };
 
 
-inline int dubMix::getCtl() const
+typedef basicDubMix<int> dubMix;
+typedef basicDubMix<std::int16_t> dubMix16;
+typedef basicDubMix<std::int64_t> dubMix64;
+// dubMixes of int, 16-bit and 64-bit values.
+
+
+template <typename T>
+inline int basicDubMix<T>::getCtl() const
 {
 	return _ctl;
 }
 
 
-inline const numMixer& dubMix::x() const
+template <typename T>
+inline bool basicDubMix<T>::sortedOutput() const
+{
+	return _sortedOutput;
+}
+
+
+template <typename T>
+inline const typename basicDubMix<T>::mixPipeline&
+basicDubMix<T>::pipeline() const
+{
+	return _pipeline;
+}
+
+
+template <typename T>
+inline const typename basicDubMix<T>::numMixer& basicDubMix<T>::x() const
 {
 	return _x;
 }
 
 
-inline const numMixer& dubMix::z() const
+template <typename T>
+inline const typename basicDubMix<T>::numMixer& basicDubMix<T>::z() const
 {
 	return _z;
 }
 
 
-inline bool operator==(const dubMix& lhs, const dubMix& rhs)
+template <typename T>
+inline std::size_t basicDubMix<T>::hash() const
+{
+	return hashCombine(hashCombine(hashCombine(_ctl, _sortedOutput),
+								   _x.hash()),
+					   _z.hash());
+}
+
+
+template <typename T>
+inline bool operator==(const basicDubMix<T>& lhs,
+					   const basicDubMix<T>& rhs)
 {
 	return (lhs._ctl == rhs._ctl &&
+			lhs._sortedOutput == rhs._sortedOutput &&
 			lhs._x == rhs._x &&
 			lhs._z == rhs._z);
 }
 
 
-inline bool operator!=(const dubMix& lhs, const dubMix& rhs)
+template <typename T>
+inline bool operator!=(const basicDubMix<T>& lhs,
+					   const basicDubMix<T>& rhs)
 {
 	return !operator==(lhs, rhs);
 }
 
 
-inline bool operator<(const dubMix& lhs, const dubMix& rhs)
+template <typename T>
+inline bool operator<(const basicDubMix<T>& lhs,
+					  const basicDubMix<T>& rhs)
 {
 	return (lhs._x < rhs._x &&
 			lhs._z < rhs._z);
 }
 
 
-inline bool operator>(const dubMix& lhs, const dubMix& rhs)
+template <typename T>
+inline bool operator>(const basicDubMix<T>& lhs,
+					  const basicDubMix<T>& rhs)
 {
 	return operator<(rhs, lhs);
 }
 
 
-inline bool operator<=(const dubMix& lhs, const dubMix& rhs)
+template <typename T>
+inline bool operator<=(const basicDubMix<T>& lhs,
+					   const basicDubMix<T>& rhs)
 {
 	return !operator>(lhs, rhs);
 }
 
 
-inline bool operator>=(const dubMix& lhs, const dubMix& rhs)
+template <typename T>
+inline bool operator>=(const basicDubMix<T>& lhs,
+					   const basicDubMix<T>& rhs)
 {
 	return !operator<(lhs, rhs);
 }
 
 
-inline dubMix operator+(dubMix lhs, const dubMix& rhs)
+template <typename T>
+inline basicDubMix<T> operator+(basicDubMix<T> lhs,
+								const basicDubMix<T>& rhs)
 {
 	lhs += rhs;
 	return lhs;
 }
 
 
-inline dubMix& dubMix::operator+=(const dubMix& obj)
+template <typename T>
+inline basicDubMix<T>& basicDubMix<T>::operator+=(const basicDubMix& obj)
 {
 	_x += obj._x;
 	_z += obj._z;
@@ -285,4 +455,19 @@ inline dubMix& dubMix::operator+=(const dubMix& obj)
 }
 
 
+namespace std
+{
+	template <typename T>
+	struct hash<basicDubMix<T> >
+	{
+		std::size_t operator()(const basicDubMix<T>& obj) const
+		{
+			return obj.hash();
+		}
+	};
+}
+// Description:
+// * Lets dubMixes be used as keys in unordered containers.
+
+
 #endif
\ No newline at end of file
@@ -0,0 +1,210 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: mixAsync.h
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// DESCRIPTION:
+// * Asynchronous pings for numMixer, dubMix and multiMix. Pings run on a
+// mixExecutor, so callers on an event loop are not blocked by them.
+// * Every ping comes in three forms:
+//   1. pingThen() calls back with the result, on the worker that pinged.
+//   2. pingAsync() returns a std::future for the result.
+//   3. pingAwait() returns a C++20 awaitable, which resumes the awaiting
+//   coroutine with the result, on the worker that pinged. Only available when
+//   compiled with coroutine support.
+// * pingAll*() pings a batch of numMixers, fanned out over the workers of the
+// executor.
+
+// ASSUMPTIONS:
+// * The synchronous ping() of every mixer is unchanged.
+// * A numMixer ping that fails yields an empty vector.
+// * The pinged mixer must outlive the ping, and must not be used by anyone
+// else until the result is delivered.
+// * Callbacks run on a worker, and must not throw or block on the executor.
+// * The project builds as C++11, in which pingAwait() does not exist.
+// compilecoroutines.ps1 builds the sources as C++20, with the coroutine path,
+// so that it is compiled too.
+
+
+#ifndef mixAsync_INCLUDED
+#define mixAsync_INCLUDED
+
+
+#include <functional>  // function
+#include <future>  // future
+#include <utility>  // move
+#include <vector>  // vector
+
+
+#include "../include/dubMix.h"
+#include "../include/mixExecutor.h"
+#include "../include/multiMix.h"
+#include "../include/numMixer.h"
+
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define MIX_ASYNC_COROUTINES
+#include <coroutine>  // coroutine_handle
+#endif
+#endif
+
+
+typedef std::function<void(std::vector<int>)> pingCallback;
+// Receives the result of a ping.
+
+typedef std::function<void(std::vector<std::vector<int> >)> pingAllCallback;
+// Receives the results of a batch ping, one per numMixer.
+
+
+void pingThen(numMixer& obj,
+			  unsigned int size,
+			  pingCallback done,
+			  mixExecutor& executor = defaultMixExecutor());  // 1
+void pingThen(dubMix& obj,
+			  unsigned int size,
+			  pingCallback done,
+			  mixExecutor& executor = defaultMixExecutor());  // 2
+void pingThen(multiMix& obj,
+			  pingCallback done,
+			  mixExecutor& executor = defaultMixExecutor());  // 3
+// Description (1-3):
+// * Pings "obj" on "executor", then calls "done" with the result.
+// * (1) requests "size" values, (2) requests "size" values from each
+// numMixer, (3) pings the multiMix once.
+
+
+void pingAllThen(std::vector<numMixer>& mixers,
+				 unsigned int size,
+				 pingAllCallback done,
+				 mixExecutor& executor = defaultMixExecutor());
+// Description:
+// * Pings every numMixer of "mixers" for "size" values, split into one chunk
+// per worker of "executor", then calls "done" with the results, in the order
+// of "mixers".
+// * "done" is called by the worker that finishes last.
+
+
+std::future<std::vector<int> > pingAsync(
+		numMixer& obj,
+		unsigned int size,
+		mixExecutor& executor = defaultMixExecutor());  // 1
+std::future<std::vector<int> > pingAsync(
+		dubMix& obj,
+		unsigned int size,
+		mixExecutor& executor = defaultMixExecutor());  // 2
+std::future<std::vector<int> > pingAsync(
+		multiMix& obj,
+		mixExecutor& executor = defaultMixExecutor());  // 3
+std::future<std::vector<std::vector<int> > > pingAllAsync(
+		std::vector<numMixer>& mixers,
+		unsigned int size,
+		mixExecutor& executor = defaultMixExecutor());  // 4
+// Description (1-4):
+// * Same as pingThen()/pingAllThen(), but returns a future for the result.
+
+
+#ifdef MIX_ASYNC_COROUTINES
+
+
+template <typename Result>
+class mixAwaitable
+{
+	public:
+		typedef std::function<void(std::function<void(Result)>)> Start;
+		// Starts the ping, and calls its argument with the result.
+
+		explicit mixAwaitable(Start start):
+			_start(std::move(start)),
+			_result()
+		{
+		}
+
+		bool await_ready() const noexcept
+		{
+			return false;
+		}
+
+		void await_suspend(std::coroutine_handle<> caller)
+		{
+			// the caller may be resumed, destroying *this, before _start
+			// returns
+			Start start = std::move(_start);
+			start([this, caller](Result result) {
+				_result = std::move(result);
+				caller.resume();
+			});
+		}
+
+		Result await_resume()
+		{
+			return std::move(_result);
+		}
+
+	private:
+		Start _start;
+		// Starts the ping.
+
+		Result _result;
+		// Result handed to the awaiting coroutine.
+};
+// Description:
+// * Suspends the awaiting coroutine until the ping started by "start" is
+// done, then resumes it with the result, on the worker that pinged.
+
+
+inline mixAwaitable<std::vector<int> > pingAwait(
+		numMixer& obj,
+		unsigned int size,
+		mixExecutor& executor = defaultMixExecutor())  // 1
+{
+	return mixAwaitable<std::vector<int> >(
+		[&obj, size, &executor](pingCallback done) {
+			pingThen(obj, size, std::move(done), executor);
+		});
+}
+
+
+inline mixAwaitable<std::vector<int> > pingAwait(
+		dubMix& obj,
+		unsigned int size,
+		mixExecutor& executor = defaultMixExecutor())  // 2
+{
+	return mixAwaitable<std::vector<int> >(
+		[&obj, size, &executor](pingCallback done) {
+			pingThen(obj, size, std::move(done), executor);
+		});
+}
+
+
+inline mixAwaitable<std::vector<int> > pingAwait(
+		multiMix& obj,
+		mixExecutor& executor = defaultMixExecutor())  // 3
+{
+	return mixAwaitable<std::vector<int> >(
+		[&obj, &executor](pingCallback done) {
+			pingThen(obj, std::move(done), executor);
+		});
+}
+
+
+inline mixAwaitable<std::vector<std::vector<int> > > pingAllAwait(
+		std::vector<numMixer>& mixers,
+		unsigned int size,
+		mixExecutor& executor = defaultMixExecutor())  // 4
+{
+	return mixAwaitable<std::vector<std::vector<int> > >(
+		[&mixers, size, &executor](pingAllCallback done) {
+			pingAllThen(mixers, size, std::move(done), executor);
+		});
+}
+// Description (1-4):
+// * Same as pingThen()/pingAllThen(), but returns an awaitable for the
+// result.
+
+
+#endif
+
+
+#endif
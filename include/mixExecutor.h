@@ -0,0 +1,144 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: mixExecutor.h
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Class Invariant:
+// * The executor owns a fixed amount of worker threads, started on
+// construction and joined on destruction.
+// * Tasks are run in the order they are posted, by whichever worker is free.
+
+// Interface Invariant:
+// * post() queues a task and returns immediately.
+// * submit() queues a task and returns a future for its result, or for the
+// exception it throws.
+
+// DESCRIPTION:
+// * mixExecutor is a small thread pool that runs mixer pings in the
+// background, so callers on an event loop are not blocked by large batch
+// pings.
+
+// ASSUMPTIONS:
+// * Destroying the executor runs the tasks still queued, then joins the
+// workers.
+// * defaultMixExecutor() is shared by the whole process, and has one worker
+// per hardware thread.
+// * Tasks must not block on other tasks of the same executor.
+// * Tasks passed to post() must not throw. Tasks passed to submit() may,
+// their exception is stored in the future.
+
+
+#ifndef mixExecutor_INCLUDED
+#define mixExecutor_INCLUDED
+
+
+#include <condition_variable>  // condition_variable
+#include <deque>  // deque
+#include <functional>  // function
+#include <future>  // future, packaged_task
+#include <memory>  // make_shared
+#include <mutex>  // mutex
+#include <thread>  // thread
+#include <utility>  // declval, move
+#include <vector>  // vector
+
+
+class mixExecutor
+{
+	public:
+		// Constructors
+
+		explicit mixExecutor(unsigned int threadCount = 0);
+		// Description:
+		// * Starts "threadCount" worker threads. A "threadCount" of 0 starts
+		// one per hardware thread.
+
+		mixExecutor(const mixExecutor& obj) = delete;  // 1
+		mixExecutor& operator=(const mixExecutor& obj) = delete;  // 2
+		// Description (1-2):
+		// * Executors own their threads, and can not be copied.
+
+
+		// Destructors
+
+		~mixExecutor();
+		// Description:
+		// * Runs the queued tasks, then joins the workers.
+
+
+		// Functionality
+
+		void post(std::function<void()> task);
+		// Description:
+		// * Queues "task" to run on a worker.
+
+		template <typename Task>
+		std::future<decltype(std::declval<Task>()())> submit(Task task);
+		// Description:
+		// * Queues "task" to run on a worker.
+		// * Returns a future for the result of "task", or the exception it
+		// throws.
+
+
+		// Accessors
+
+		unsigned int threadCount() const;
+		// Description:
+		// * Returns the amount of worker threads.
+
+
+	private:
+		// Utility
+
+		void work();
+		// Description:
+		// * Worker loop, runs tasks until the executor is stopped and the queue
+		// is empty.
+
+
+		// Members
+
+		std::mutex _mutex;
+		// Guards "_tasks" and "_stopping".
+
+		std::condition_variable _wake;
+		// Signalled when a task is queued, or the executor stops.
+
+		std::deque<std::function<void()> > _tasks;
+		// Tasks waiting for a worker.
+
+		bool _stopping;
+		// Set on destruction, tells the workers to exit once "_tasks" is empty.
+
+		std::vector<std::thread> _workers;
+		// Worker threads.
+};
+
+
+mixExecutor& defaultMixExecutor();
+// Description:
+// * Returns the process-wide executor, creating it on the first call.
+
+
+template <typename Task>
+std::future<decltype(std::declval<Task>()())>
+mixExecutor::submit(Task task)
+{
+	typedef decltype(std::declval<Task>()()) Result;
+	// std::function needs a copyable target, so the task is shared
+	auto packaged = std::make_shared<std::packaged_task<Result()> >(
+			std::move(task));
+	std::future<Result> result = packaged->get_future();
+	post([packaged]() { (*packaged)(); });
+	return result;
+}
+
+
+inline unsigned int mixExecutor::threadCount() const
+{
+	return _workers.size();
+}
+
+
+#endif
@@ -0,0 +1,46 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: mixHash.h
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// DESCRIPTION:
+// * Hashing helpers shared by the mixer classes to build their fingerprints.
+
+// ASSUMPTIONS:
+// * Fingerprints are used to decide inequality quickly, and as keys in hash
+// maps. Equal objects always have equal fingerprints, but equal fingerprints
+// do not imply equal objects.
+// * mixHash() is the splitmix64 finalizer, which spreads every input bit over
+// the whole output.
+// * Multiset (order independent) hashes are built by summing mixHash() of the
+// elements, so adding/removing an element updates the hash in O(1).
+
+
+#ifndef mixHash_INCLUDED
+#define mixHash_INCLUDED
+
+
+#include <cstdint>  // uint64_t
+
+
+inline std::uint64_t mixHash(std::uint64_t val)
+{
+	val += 0x9e3779b97f4a7c15ULL;
+	val = (val ^ (val >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	val = (val ^ (val >> 27)) * 0x94d049bb133111ebULL;
+	return val ^ (val >> 31);
+}
+// Description:
+// * Returns a well distributed 64-bit hash of "val".
+
+
+inline std::uint64_t hashCombine(std::uint64_t seed, std::uint64_t val)
+{
+	return mixHash(seed ^ (val + 0x9e3779b97f4a7c15ULL + (seed << 6)));
+}
+// Description:
+// * Returns a hash of "seed" followed by "val". Order sensitive.
+
+
+#endif
@@ -0,0 +1,134 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: mixKernels.h
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// DESCRIPTION:
+// * Data movement kernels used to assemble mixer output.
+// * interleave() merges two arrays into alternating values.
+// * unpackBits() expands bit-packed values (see packedDataset.h).
+// * sortValues() and sortUniqueValues() order mixer output in linear time.
+
+// ASSUMPTIONS:
+// * Kernels are templates over the value type, instantiated for std::int16_t,
+// int and std::int64_t (the value types of the mixers).
+// * interleave() has AVX2, SSE2 and scalar variants. The fastest variant the
+// CPU supports is chosen once, at the first call. A vector holds 16, 8 or 4
+// values of 16, 32 or 64 bits, so narrower values interleave more per
+// instruction.
+// * SIMD variants are only built for x86 with GCC compatible compilers, other
+// platforms always use the scalar variant.
+// * unpackBits() has an AVX2 variant for int values of up to 25 bits, which
+// gathers 8 fields per instruction. Other value types and widths use the
+// scalar variant.
+// * sortValues() counting sorts values whose range is narrow compared to
+// their count, which mixer output is (datasets span a few hundred values at
+// most), and radix sorts wider ranges a byte at a time. Fewer than 64 values
+// are sorted with std::sort, which beats clearing the counts at that size.
+// sortUniqueValues() drops duplicates in the same pass.
+// * Kernels write straight into the caller's output buffer.
+
+
+#ifndef mixKernels_INCLUDED
+#define mixKernels_INCLUDED
+
+
+#include <cstddef>  // size_t
+#include <cstdint>  // uint64_t
+
+
+template <typename T>
+void interleave(const T* even, const T* odd, T* out, std::size_t count);
+// Description:
+// * Stores "even[i]" into "out[2 * i]" and "odd[i]" into "out[2 * i + 1]",
+// for every i < "count".
+//
+// Preconditions:
+// * "out" must have room for 2 * "count" values.
+// * "out" must not overlap "even" or "odd".
+
+
+template <typename T>
+void interleaveScalar(const T* even,
+					  const T* odd,
+					  T* out,
+					  std::size_t count);
+// Description:
+// * Scalar variant of interleave(), available for comparison.
+
+
+inline std::uint64_t unpackField(const std::uint64_t* words,
+								 unsigned int width,
+								 std::size_t index)
+{
+	const std::uint64_t BIT = static_cast<std::uint64_t>(index) * width;
+	const unsigned int SHIFT = BIT % 64;
+	std::uint64_t field = words[BIT / 64] >> SHIFT;
+	if (SHIFT + width > 64) {
+		// straddles two words
+		field |= words[BIT / 64 + 1] << (64 - SHIFT);
+	}
+	return field & ((std::uint64_t(1) << width) - 1);
+}
+// Description:
+// * Returns field "index" of "words", a packed array of "width"-bit fields,
+// field i starting at bit i * "width".
+//
+// Preconditions:
+// * "width" must be <= 32.
+
+
+template <typename T>
+void unpackBits(const std::uint64_t* words,
+				unsigned int width,
+				T base,
+				T* out,
+				std::size_t count);
+// Description:
+// * Stores "base" + unpackField(words, width, i) into "out[i]", for every
+// i < "count".
+//
+// Preconditions:
+// * "width" must be <= 32.
+// * "words" must hold one word past the last field.
+
+
+template <typename T>
+void unpackBitsScalar(const std::uint64_t* words,
+					  unsigned int width,
+					  T base,
+					  T* out,
+					  std::size_t count);
+// Description:
+// * Scalar variant of unpackBits(), available for comparison.
+
+
+template <typename T>
+void sortValues(T* values, std::size_t count);
+// Description:
+// * Sorts the "count" values of "values" in ascending order, in place.
+
+
+template <typename T>
+std::size_t sortUniqueValues(T* values, std::size_t count);
+// Description:
+// * Sorts the "count" values of "values" in ascending order, in place, and
+// drops duplicates.
+// * Returns the amount of distinct values, which are kept at the front of
+// "values". Values past it are unspecified.
+
+
+const char* interleaveKernelName();
+// Description:
+// * Returns the name of the interleave() variant in use ("AVX2", "SSE2" or
+// "scalar").
+
+
+const char* unpackBitsKernelName();
+// Description:
+// * Returns the name of the int unpackBits() variant in use ("AVX2" or
+// "scalar").
+
+
+#endif
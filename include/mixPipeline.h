@@ -0,0 +1,242 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: mixPipeline.h
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Class Invariant:
+// * A mixPipeline is an ordered list of stages, each a filter (which drops
+// values) or a transform (which rewrites them), plus whether duplicates are
+// removed.
+// * An empty pipeline passes every value through unchanged.
+
+// Interface Invariant:
+// * Pipelines are built by adding stages through the mutators, which return
+// the pipeline so calls can be chained, i.e.
+// mixPipeline().keepEven().keepRange(10, 50).
+// * apply() runs the pipeline over a buffer in place, and returns how many
+// values are left.
+// * primePurge() and duplicatePurge() are the post-processing the mixers have
+// always done: multiMix drops primes from "Mix" pings, dubMix drops
+// duplicates from ctl 4 pings.
+
+// DESCRIPTION:
+// * mixPipeline post-processes the values of a ping. Stages are fused over
+// cache-sized blocks of the ping, so any amount of filters and transforms
+// costs one pass over its memory.
+
+// ASSUMPTIONS:
+// * Stages run in the order they were added. A value dropped by a filter is
+// not seen by the stages after it.
+// * Values are processed in blocks of 256. Every stage runs over a block,
+// which stays in the L1 cache, before the next block is read, so each stage
+// is a tight loop of its own, and built-in filters compact without
+// branching.
+// * Duplicates are removed from the values that pass every stage, whichever
+// order dedup was set in, so the output holds no value twice.
+// * Kept values are compacted to the front of the buffer in their original
+// order, so output that was sorted, or had evens before odds, stays that way.
+// * Duplicates are found through a hash set, on the stack for small pings, and
+// kept per thread and reused for larger ones.
+// * Custom filters and transforms are std::functions, called once per value
+// that reaches them. Pipelines hold them by value, so they are copied along
+// with the pipeline.
+// * basicMixPipeline<T> processes values of type T (see numMixer.h). The value
+// types are instantiated at the bottom of mixPipeline.cpp.
+
+
+#ifndef mixPipeline_INCLUDED
+#define mixPipeline_INCLUDED
+
+
+#include <cstddef>  // size_t
+#include <cstdint>  // int16_t, int64_t
+#include <functional>  // function
+#include <vector>  // vector
+
+
+#include "../include/mixResult.h"
+
+
+template <typename T>
+class basicMixPipeline
+{
+	public:
+		// Types
+
+		typedef T value_type;
+		typedef basicMixResult<T> mixResult;
+		// Values and results of the pipeline's value type.
+
+		typedef std::function<bool(T)> Filter;
+		typedef std::function<T(T)> Transform;
+		// Custom stages. A filter returns whether to keep a value, a
+		// transform returns the value to put in its place.
+
+
+		// Constructors
+
+		basicMixPipeline();
+		// Description:
+		// * Creates an empty pipeline, which passes every value through.
+
+		static basicMixPipeline primePurge();
+		// Description:
+		// * Returns a pipeline dropping primes, as tested by the value type
+		// (see mixValue.h). multiMix runs it on "Mix" pings.
+
+		static basicMixPipeline duplicatePurge();
+		// Description:
+		// * Returns a pipeline dropping duplicates, keeping the first of each
+		// value. dubMix runs it on ctl 4 pings.
+
+
+		// Functionality
+
+		std::size_t apply(T* values, std::size_t size,
+						  bool dedup = false) const;
+		// Description:
+		// * Runs the pipeline over the "size" values of "values", in one pass,
+		// compacting the values kept to the front.
+		// * Duplicates are also removed if "dedup" is set, even if the pipeline
+		// does not remove them.
+		// * Returns the amount of values kept. Values past it are left
+		// unspecified.
+
+		void apply(mixResult& result, bool dedup = false) const;
+		// Description:
+		// * Same as apply(values, size, dedup) over "result", which is then
+		// resized to the values kept.
+
+
+		// Accessors
+
+		bool empty() const;
+		// Description:
+		// * Returns whether the pipeline has no stages and keeps duplicates,
+		// i.e. whether it passes every value through unchanged.
+
+		std::size_t stageCount() const;
+		// Description:
+		// * Returns the amount of filters and transforms.
+
+		bool dedup() const;
+		// Description:
+		// * Returns whether duplicates are removed.
+
+
+		// Mutators
+
+		basicMixPipeline& keepEven();  // 1
+		basicMixPipeline& keepOdd();  // 2
+		// Description (1-2):
+		// * Add a filter keeping even (1) or odd (2) values only.
+
+		basicMixPipeline& dropPrimes();
+		// Description:
+		// * Adds a filter dropping primes.
+
+		basicMixPipeline& keepRange(T low, T high);
+		// Description:
+		// * Adds a filter keeping values in [low, high] only.
+
+		basicMixPipeline& keepIf(Filter filter);
+		// Description:
+		// * Adds a filter keeping the values "filter" returns true for.
+
+		basicMixPipeline& transform(Transform fn);
+		// Description:
+		// * Adds a stage replacing every value by what "fn" returns for it.
+
+		basicMixPipeline& setDedup(bool dedup = true);
+		// Description:
+		// * Sets whether duplicates are removed.
+
+
+	private:
+		// Types
+
+		enum StageKind { EVEN, ODD, NO_PRIMES, RANGE, FILTER, TRANSFORM };
+		// Kinds of stages. Built-in filters are run inline, only FILTER and
+		// TRANSFORM call out.
+
+		struct stage
+		{
+			StageKind kind;
+			T low;
+			T high;
+			Filter filter;
+			Transform transform;
+		};
+		// A stage, with the bounds of a RANGE, or the function of a FILTER or
+		// TRANSFORM.
+
+
+		// Utility
+
+		static std::size_t runStage(const stage& rStage, const T* in, T* out,
+									std::size_t count);
+		// Description:
+		// * Runs "rStage" over the "count" values of "in", storing the values
+		// kept into "out", and returns their amount.
+		//
+		// Preconditions:
+		// * "out" must not be past "in". They may overlap.
+
+		basicMixPipeline& addStage(StageKind kind);
+		// Description:
+		// * Appends a stage of kind "kind", and returns the pipeline.
+
+
+		// Members
+
+		static const std::size_t _BLOCK = 256;
+		// Values per block.
+
+		static const std::size_t _SMALL_DEDUP = 32;
+		// Pings up to this size find duplicates through a hash set on the
+		// stack, larger ones through a hash set of the thread.
+
+		std::vector<stage> _stages;
+		// Stages, in the order they run.
+
+		bool _dedup;
+		// Whether duplicates are removed.
+};
+
+
+typedef basicMixPipeline<int> mixPipeline;
+typedef basicMixPipeline<std::int16_t> mixPipeline16;
+typedef basicMixPipeline<std::int64_t> mixPipeline64;
+// Pipelines of int, 16-bit and 64-bit values.
+
+
+template <typename T>
+inline void basicMixPipeline<T>::apply(mixResult& result, bool dedup) const
+{
+	result.resize(apply(result.data(), result.size(), dedup));
+}
+
+
+template <typename T>
+inline bool basicMixPipeline<T>::empty() const
+{
+	return _stages.empty() && !_dedup;
+}
+
+
+template <typename T>
+inline std::size_t basicMixPipeline<T>::stageCount() const
+{
+	return _stages.size();
+}
+
+
+template <typename T>
+inline bool basicMixPipeline<T>::dedup() const
+{
+	return _dedup;
+}
+
+
+#endif
@@ -0,0 +1,194 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: mixPlan.h
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Class Invariant:
+// * A mixPlan is compiled once, at construction, and is immutable afterwards.
+// * The plan describes how many values to pull from each source per ping, and
+// where each output value is gathered from.
+
+// Interface Invariant:
+// * Sources are numbered 0 to sourceCount() - 1.
+// * Values pulled from the sources are laid out back to back in one buffer,
+// source 0 first. pullOffset(s) is where the values of source "s" start.
+// * Output value "k" is gathered from index gather()[k] of that buffer.
+
+// DESCRIPTION:
+// * mixPlan compiles a mixing pattern over N sources into a gather plan, so a
+// mixer can run the pattern with one batched pull per source and one
+// branch-free gather.
+
+// ASSUMPTIONS:
+// * Each source has a weight, "weights[s]", and the pattern is repeated
+// "rounds" times.
+// * ROUND_ROBIN: each round visits the sources in turn, one value at a time,
+// skipping sources that have already given "weights[s]" values that round
+// (e.g. weights { 2, 1 } yields s0 s1 s0 per round). Weights { 1, 1 } are
+// equivalent to dubMix ctl 3.
+// * BLOCKS: each round takes a block of "weights[s]" consecutive values from
+// every source in turn (e.g. weights { 2, 1 } yields s0 s0 s1 per round).
+// * CONCATENATE: all "weights[s]" * "rounds" values of source 0, then source 1,
+// and so on.
+// * If "dedup" is set, duplicate values are removed from the output, keeping
+// the first occurrence. CONCATENATE with dedup over an EVEN and an ODD source
+// is equivalent to dubMix ctl 4.
+
+
+#ifndef mixPlan_INCLUDED
+#define mixPlan_INCLUDED
+
+
+#include <vector>  // vector
+
+
+class mixPlan
+{
+	public:
+		// Types
+
+		enum Pattern { ROUND_ROBIN, BLOCKS, CONCATENATE };
+		// Patterns a plan can be compiled from.
+
+
+		// Constructors
+
+		mixPlan();
+		// Description:
+		// * Creates an empty plan, over no sources.
+
+		mixPlan(Pattern pattern,
+				const std::vector<unsigned int>& weights,
+				unsigned int rounds = 1,
+				bool dedup = false);
+		// Description:
+		// * Compiles "pattern" over "weights.size()" sources into a gather
+		// plan.
+		//
+		// Preconditions:
+		// * "weights" should contain at least one weight > 0.
+		// * "rounds" should be > 0.
+		//
+		// Postconditions:
+		// * The plan pulls "weights[s]" * "rounds" values from source "s".
+
+
+		// Accessors
+
+		Pattern pattern() const;
+		// Description:
+		// * Returns the pattern the plan was compiled from.
+
+		bool dedup() const;
+		// Description:
+		// * Returns whether duplicates are removed from the output.
+
+		unsigned int sourceCount() const;
+		// Description:
+		// * Returns the amount of sources the plan mixes.
+
+		unsigned int pullCount(unsigned int source) const;
+		// Description:
+		// * Returns the amount of values pulled from "source" per ping.
+
+		unsigned int pullOffset(unsigned int source) const;
+		// Description:
+		// * Returns where the values of "source" start in the pull buffer.
+
+		unsigned int pullTotal() const;
+		// Description:
+		// * Returns the size of the pull buffer, and of the output before
+		// dedup.
+
+		const std::vector<unsigned int>& gather() const;
+		// Description:
+		// * Returns the gather plan. Output value "k" is taken from index
+		// gather()[k] of the pull buffer.
+
+
+		// Comparison Operators
+
+		friend bool operator==(const mixPlan& lhs, const mixPlan& rhs);  // 1
+		friend bool operator!=(const mixPlan& lhs, const mixPlan& rhs);  // 2
+		// Description (1-2):
+		// * Checks if the plans gather the same values in the same order.
+
+
+	private:
+		// Members
+
+		Pattern _pattern;
+		// Pattern the plan was compiled from.
+
+		bool _dedup;
+		// Whether duplicates are removed from the output.
+
+		std::vector<unsigned int> _pullCounts;
+		// Values pulled from each source per ping.
+
+		std::vector<unsigned int> _pullOffsets;
+		// Start of each source's values in the pull buffer.
+
+		std::vector<unsigned int> _gather;
+		// Pull buffer index of every output value.
+};
+
+
+inline mixPlan::Pattern mixPlan::pattern() const
+{
+	return _pattern;
+}
+
+
+inline bool mixPlan::dedup() const
+{
+	return _dedup;
+}
+
+
+inline unsigned int mixPlan::sourceCount() const
+{
+	return _pullCounts.size();
+}
+
+
+inline unsigned int mixPlan::pullCount(unsigned int source) const
+{
+	return _pullCounts[source];
+}
+
+
+inline unsigned int mixPlan::pullOffset(unsigned int source) const
+{
+	return _pullOffsets[source];
+}
+
+
+inline unsigned int mixPlan::pullTotal() const
+{
+	return _gather.size();
+}
+
+
+inline const std::vector<unsigned int>& mixPlan::gather() const
+{
+	return _gather;
+}
+
+
+inline bool operator==(const mixPlan& lhs, const mixPlan& rhs)
+{
+	return (lhs._dedup == rhs._dedup &&
+			lhs._pullCounts == rhs._pullCounts &&
+			lhs._gather == rhs._gather);
+}
+
+
+inline bool operator!=(const mixPlan& lhs, const mixPlan& rhs)
+{
+	return !operator==(lhs, rhs);
+}
+
+
+#endif
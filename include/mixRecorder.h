@@ -0,0 +1,342 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: mixRecorder.h
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Class Invariant:
+// * A mixRecorder owns a session of mixers, identified by ids, and seeds the
+// rngs of its thread once, on construction.
+// * Every operation on the session is appended to the log, if there is one,
+// in the order it is performed.
+// * A running checksum covers every value output by the session.
+
+// Interface Invariant:
+// * Mixers are created and operated on through the recorder, so no operation
+// escapes the log. Mixers are handed out read-only.
+// * ids are handed out per mixer type, counting from 0.
+// * mixReplayer reads a log and performs its operations on a session of its
+// own, which reproduces the recorded output exactly.
+
+// DESCRIPTION:
+// * mixRecorder records mixer traffic to a compact binary log, so odd output
+// seen in production can be reproduced offline with mixReplayer (see
+// tools/mixReplay.cpp).
+
+// ASSUMPTIONS:
+// * All mixer randomness comes from the thread's rngs (see mixSeed.h), so
+// seeding them and replaying the same operations in order reproduces the
+// output. Hence every mixer used on the recording thread must belong to the
+// session, and the recorded mixers must not use a randomReservoir.
+// * The log holds a header (magic, version, seed), one record per operation
+// (an opcode and its arguments as LEB128 varints, signed values zigzagged),
+// and a trailer (operation count, checksum), written by finish() or the
+// destructor.
+// * The log is buffered, and written to the stream in large blocks.
+// * A recorder without a log performs the operations without recording them,
+// which is how mixReplayer replays a log.
+
+
+#ifndef mixRecorder_INCLUDED
+#define mixRecorder_INCLUDED
+
+
+#include <cstdint>  // uint32_t, uint64_t, int64_t
+#include <istream>  // istream
+#include <ostream>  // ostream
+#include <string>  // string
+#include <vector>  // vector
+
+
+#include "../include/dubMix.h"
+#include "../include/multiMix.h"
+#include "../include/numMixer.h"
+
+
+class mixRecorder
+{
+	public:
+		// Constructors
+
+		mixRecorder(std::ostream* log, std::uint32_t seed);
+		// Description:
+		// * Starts a session, seeding the rngs of the calling thread from
+		// "seed", and writes the log header to "log".
+		// * A null "log" runs the session without recording it.
+
+		mixRecorder(const mixRecorder& obj) = delete;  // 1
+		mixRecorder& operator=(const mixRecorder& obj) = delete;  // 2
+		// Description (1-2):
+		// * A session is tied to its log, and can not be copied.
+
+
+		// Destructors
+
+		~mixRecorder();
+		// Description:
+		// * Calls finish().
+
+
+		// Functionality
+
+		unsigned int createNumMixer(const std::vector<int>& dataset);  // 1
+		unsigned int createDubMix();  // 2
+		unsigned int createMultiMix();  // 3
+		// Description (1-3):
+		// * Adds a mixer to the session, and returns its id.
+		// * (1) is seeded with "dataset", which is recorded in full.
+
+		void setControllerState(unsigned int id,
+								numMixer::OutputController state);
+		bool pingNumMixer(unsigned int id, std::vector<int>& returnValues);
+		// Description:
+		// * Same as numMixer::setControllerState() and numMixer::ping(), on
+		// numMixer "id".
+
+		void setCtl(unsigned int id, unsigned int ctl);
+		mixResult pingDubMix(unsigned int id, unsigned int size);
+		// Description:
+		// * Same as dubMix::setCtl() and dubMix::ping(size), on dubMix "id".
+
+		void addNumMixers(unsigned int id, unsigned int count);
+		void addNumMixersParallel(unsigned int id,
+								  unsigned int count,
+								  unsigned int threadCount);
+		void removeNumMixers(unsigned int id, unsigned int count);
+		void setSchedulePolicy(unsigned int id,
+							   multiMix::SchedulePolicy policy);
+		mixResult pingMultiMix(unsigned int id);
+		// Description:
+		// * Same as the multiMix operations of the same name, on multiMix
+		// "id".
+
+		void finish();
+		// Description:
+		// * Writes the log trailer, and flushes the log. Operations after
+		// finish() are performed, but not recorded.
+
+
+		// Accessors
+
+		const numMixer& getNumMixer(unsigned int id) const;
+		const dubMix& getDubMix(unsigned int id) const;
+		const multiMix& getMultiMix(unsigned int id) const;
+		// Description:
+		// * Returns mixer "id" of the given type.
+
+		unsigned int numMixerCount() const;
+		unsigned int dubMixCount() const;
+		unsigned int multiMixCount() const;
+		// Description:
+		// * Returns the amount of mixers of the given type.
+
+		std::uint32_t seed() const;
+		// Description:
+		// * Returns the seed of the session.
+
+		std::uint64_t operations() const;
+		// Description:
+		// * Returns the amount of operations performed.
+
+		std::uint64_t checksum() const;
+		// Description:
+		// * Returns the checksum of every value output so far, in order.
+
+
+	private:
+		// Utility
+
+		void writeVarint(std::uint64_t val);
+		void writeSigned(std::int64_t val);
+		void writeOp(unsigned int opcode);
+		// Description:
+		// * Append an unsigned varint, a zigzagged signed varint and an
+		// opcode to the log buffer, if recording.
+
+		void flushBuffer();
+		// Description:
+		// * Writes the log buffer to the log.
+
+		void checksumValues(const int* values, std::size_t count, bool pinged);
+		// Description:
+		// * Adds the outcome of a ping to the checksum.
+
+
+		// Members
+
+		std::ostream* _log;
+		// Log the session is recorded to, null if not recording.
+
+		std::vector<unsigned char> _buffer;
+		// Records not yet written to "_log".
+
+		std::uint32_t _seed;
+		// Seed of the session.
+
+		std::uint64_t _operations;
+		// Amount of operations performed.
+
+		std::uint64_t _checksum;
+		// Checksum of the output so far.
+
+		std::vector<numMixer> _numMixers;
+		std::vector<dubMix> _dubMixes;
+		std::vector<multiMix> _multiMixes;
+		// Mixers of the session, indexed by id.
+};
+
+
+class mixReplayer
+{
+	public:
+		// Constructors
+
+		explicit mixReplayer(std::istream& log);
+		// Description:
+		// * Prepares to replay "log".
+
+
+		// Functionality
+
+		bool run();
+		// Description:
+		// * Replays every operation of the log on a fresh session.
+		// * Returns true if the log is well formed and the replayed output
+		// matches the recorded checksum.
+		// * Returns false otherwise, with a reason in error().
+		//
+		// Preconditions:
+		// * Mixers on the calling thread are disturbed by the replay, as it
+		// reseeds the thread's rngs.
+
+
+		// Accessors
+
+		std::uint32_t seed() const;
+		std::uint64_t operations() const;
+		std::uint64_t checksum() const;
+		std::uint64_t recordedChecksum() const;
+		// Description:
+		// * Return the seed, amount of operations, replayed checksum and
+		// recorded checksum, as of the end of run().
+
+		const std::string& error() const;
+		// Description:
+		// * Returns why run() failed, empty if it did not.
+
+
+	private:
+		// Utility
+
+		bool readVarint(std::uint64_t& val);
+		bool readSigned(std::int64_t& val);
+		// Description:
+		// * Read an unsigned varint and a zigzagged signed varint from the
+		// log. Return false at the end of the log or on a malformed varint.
+
+		bool fail(const std::string& reason);
+		// Description:
+		// * Sets error() to "reason", and returns false.
+
+
+		// Members
+
+		std::istream& _log;
+		// Log being replayed.
+
+		std::uint32_t _seed;
+		std::uint64_t _operations;
+		std::uint64_t _checksum;
+		std::uint64_t _recordedChecksum;
+		// See the accessors.
+
+		std::string _error;
+		// Why run() failed.
+};
+
+
+inline const numMixer& mixRecorder::getNumMixer(unsigned int id) const
+{
+	return _numMixers[id];
+}
+
+
+inline const dubMix& mixRecorder::getDubMix(unsigned int id) const
+{
+	return _dubMixes[id];
+}
+
+
+inline const multiMix& mixRecorder::getMultiMix(unsigned int id) const
+{
+	return _multiMixes[id];
+}
+
+
+inline unsigned int mixRecorder::numMixerCount() const
+{
+	return _numMixers.size();
+}
+
+
+inline unsigned int mixRecorder::dubMixCount() const
+{
+	return _dubMixes.size();
+}
+
+
+inline unsigned int mixRecorder::multiMixCount() const
+{
+	return _multiMixes.size();
+}
+
+
+inline std::uint32_t mixRecorder::seed() const
+{
+	return _seed;
+}
+
+
+inline std::uint64_t mixRecorder::operations() const
+{
+	return _operations;
+}
+
+
+inline std::uint64_t mixRecorder::checksum() const
+{
+	return _checksum;
+}
+
+
+inline std::uint32_t mixReplayer::seed() const
+{
+	return _seed;
+}
+
+
+inline std::uint64_t mixReplayer::operations() const
+{
+	return _operations;
+}
+
+
+inline std::uint64_t mixReplayer::checksum() const
+{
+	return _checksum;
+}
+
+
+inline std::uint64_t mixReplayer::recordedChecksum() const
+{
+	return _recordedChecksum;
+}
+
+
+inline const std::string& mixReplayer::error() const
+{
+	return _error;
+}
+
+
+#endif
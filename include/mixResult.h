@@ -0,0 +1,350 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: mixResult.h
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Class Invariant:
+// * Values are stored inline while they fit in INLINE_CAPACITY, and on the
+// heap once they do not.
+// * Storage only grows, a result that spilled to the heap stays there until
+// it is destroyed or moved from.
+
+// Interface Invariant:
+// * basicMixResult<T> is a contiguous sequence of values of type T, with the
+// subset of the std::vector<T> interface the mixers and their clients use.
+// * New values added by resize() are 0, like std::vector<T>.
+// * mixResult is the result of the int mixers, basicMixResult<int>.
+
+// DESCRIPTION:
+// * mixResult is the result type of dubMix and multiMix pings. Ordinary pings
+// return at most 20 values, which fit inline, so returning them does not
+// allocate.
+
+// ASSUMPTIONS:
+// * Moving a spilled result takes over its heap buffer. Moving an inline
+// result copies its values. A moved-from result is empty.
+// * The inline capacity is counted in values, so narrow value types make for
+// a smaller result.
+// * Instantiated for std::int16_t, int and std::int64_t (see mixResult.cpp).
+// * Comparison (==) operators are supported, on the values.
+// * toVector() copies the values into a std::vector<T>, for clients that
+// need one.
+
+
+#ifndef mixResult_INCLUDED
+#define mixResult_INCLUDED
+
+
+#include <algorithm>  // copy, equal, fill
+#include <cstddef>  // size_t
+#include <initializer_list>  // initializer_list
+#include <vector>  // vector
+
+
+template <typename T>
+class basicMixResult
+{
+	public:
+		// Types
+
+		typedef T value_type;
+		typedef T* iterator;
+		typedef const T* const_iterator;
+		// Container types, as in std::vector<T>.
+
+		static const std::size_t INLINE_CAPACITY = 20;
+		// Amount of values stored without allocating.
+
+
+		// Constructors
+
+		basicMixResult();  // 1
+		explicit basicMixResult(std::size_t size);  // 2
+		basicMixResult(std::initializer_list<T> values);  // 3
+		// Description (1-3):
+		// * Creates an empty result (1), a result of "size" zeros (2), or a
+		// result holding "values" (3).
+
+		basicMixResult(const basicMixResult& obj);  // 1
+		basicMixResult(basicMixResult&& obj) noexcept;  // 2
+		basicMixResult& operator=(const basicMixResult& obj);  // 3
+		basicMixResult& operator=(basicMixResult&& obj) noexcept;  // 4
+		// Description (1-4):
+		// * Copies/moves the values.
+
+
+		// Destructors
+
+		~basicMixResult();
+		// Description:
+		// * Frees the heap buffer, if the result spilled.
+
+
+		// Accessors
+
+		std::size_t size() const;
+		bool empty() const;
+		std::size_t capacity() const;
+		// Description:
+		// * Return the amount of values, whether there are none, and the amount
+		// of values that fit without growing.
+
+		bool isInline() const;
+		// Description:
+		// * Returns whether the values are stored inline.
+
+		T* data();  // 1
+		const T* data() const;  // 2
+		iterator begin();  // 3
+		const_iterator begin() const;  // 4
+		iterator end();  // 5
+		const_iterator end() const;  // 6
+		T& operator[](std::size_t index);  // 7
+		const T& operator[](std::size_t index) const;  // 8
+		// Description (1-8):
+		// * Access the values, as in std::vector<T>.
+
+		std::vector<T> toVector() const;
+		// Description:
+		// * Returns a copy of the values.
+
+
+		// Mutators
+
+		void resize(std::size_t size);
+		// Description:
+		// * Resizes the result to "size" values. New values are 0.
+
+		void reserve(std::size_t capacity);
+		// Description:
+		// * Grows the storage to hold at least "capacity" values.
+
+		void clear();
+		// Description:
+		// * Removes all values, keeping the storage.
+
+		void push_back(T val);
+		// Description:
+		// * Appends "val".
+
+
+		// Comparison Operators
+
+		template <typename U>
+		friend bool operator==(const basicMixResult<U>& lhs,
+							   const basicMixResult<U>& rhs);  // 1
+		template <typename U>
+		friend bool operator!=(const basicMixResult<U>& lhs,
+							   const basicMixResult<U>& rhs);  // 2
+		// Description (1-2):
+		// * Checks if the values are the same.
+
+
+	private:
+		// Utility
+
+		void grow(std::size_t capacity);
+		// Description:
+		// * Moves the values to a heap buffer of "capacity" values.
+		//
+		// Preconditions:
+		// * "capacity" must be greater than capacity().
+
+
+		// Members
+
+		T* _data;
+		// Points to "_inline" or the heap buffer.
+
+		std::size_t _size;
+		// Amount of values.
+
+		std::size_t _capacity;
+		// Amount of values "_data" holds.
+
+		T _inline[INLINE_CAPACITY];
+		// Inline storage.
+};
+
+
+typedef basicMixResult<int> mixResult;
+// Result of the int mixers.
+
+
+template <typename T>
+inline basicMixResult<T>::basicMixResult():
+	_data(_inline),
+	_size(0),
+	_capacity(INLINE_CAPACITY)
+{
+}
+
+
+template <typename T>
+inline basicMixResult<T>::basicMixResult(std::size_t size):
+	basicMixResult()
+{
+	resize(size);
+}
+
+
+template <typename T>
+inline basicMixResult<T>::~basicMixResult()
+{
+	if (_data != _inline) {
+		delete[] _data;
+	}
+}
+
+
+template <typename T>
+inline std::size_t basicMixResult<T>::size() const
+{
+	return _size;
+}
+
+
+template <typename T>
+inline bool basicMixResult<T>::empty() const
+{
+	return _size == 0;
+}
+
+
+template <typename T>
+inline std::size_t basicMixResult<T>::capacity() const
+{
+	return _capacity;
+}
+
+
+template <typename T>
+inline bool basicMixResult<T>::isInline() const
+{
+	return _data == _inline;
+}
+
+
+template <typename T>
+inline T* basicMixResult<T>::data()
+{
+	return _data;
+}
+
+
+template <typename T>
+inline const T* basicMixResult<T>::data() const
+{
+	return _data;
+}
+
+
+template <typename T>
+inline typename basicMixResult<T>::iterator basicMixResult<T>::begin()
+{
+	return _data;
+}
+
+
+template <typename T>
+inline typename basicMixResult<T>::const_iterator
+basicMixResult<T>::begin() const
+{
+	return _data;
+}
+
+
+template <typename T>
+inline typename basicMixResult<T>::iterator basicMixResult<T>::end()
+{
+	return _data + _size;
+}
+
+
+template <typename T>
+inline typename basicMixResult<T>::const_iterator
+basicMixResult<T>::end() const
+{
+	return _data + _size;
+}
+
+
+template <typename T>
+inline T& basicMixResult<T>::operator[](std::size_t index)
+{
+	return _data[index];
+}
+
+
+template <typename T>
+inline const T& basicMixResult<T>::operator[](std::size_t index) const
+{
+	return _data[index];
+}
+
+
+template <typename T>
+inline std::vector<T> basicMixResult<T>::toVector() const
+{
+	return std::vector<T>(begin(), end());
+}
+
+
+template <typename T>
+inline void basicMixResult<T>::resize(std::size_t size)
+{
+	if (size > _capacity) {
+		grow(size);
+	}
+	if (size > _size) {
+		std::fill(_data + _size, _data + size, T());
+	}
+	_size = size;
+}
+
+
+template <typename T>
+inline void basicMixResult<T>::reserve(std::size_t capacity)
+{
+	if (capacity > _capacity) {
+		grow(capacity);
+	}
+}
+
+
+template <typename T>
+inline void basicMixResult<T>::clear()
+{
+	_size = 0;
+}
+
+
+template <typename T>
+inline void basicMixResult<T>::push_back(T val)
+{
+	if (_size == _capacity) {
+		grow(2 * _capacity);
+	}
+	_data[_size++] = val;
+}
+
+
+template <typename T>
+inline bool operator==(const basicMixResult<T>& lhs,
+					   const basicMixResult<T>& rhs)
+{
+	return (lhs._size == rhs._size &&
+			std::equal(lhs.begin(), lhs.end(), rhs.begin()));
+}
+
+
+template <typename T>
+inline bool operator!=(const basicMixResult<T>& lhs,
+					   const basicMixResult<T>& rhs)
+{
+	return !operator==(lhs, rhs);
+}
+
+
+#endif
@@ -0,0 +1,46 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: mixSeed.h
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// DESCRIPTION:
+// * Seeding helpers shared by the mixer classes to set up their rngs.
+
+// ASSUMPTIONS:
+// * The mixer classes keep one rng per thread, so threads never share rng
+// state.
+// * Threads started within the same second must not draw the same stream, so
+// every rng is seeded from the time and a process-wide counter.
+// * Neither must worker processes started within the same second, so the id
+// of the process is mixed in too, where the platform has one (POSIX).
+
+
+#ifndef mixSeed_INCLUDED
+#define mixSeed_INCLUDED
+
+
+#include <atomic>  // atomic
+#include <ctime>  // time
+#include <random>  // mt19937, seed_seq
+
+
+unsigned int processId();
+// Description:
+// * Returns the id of the calling process, or 0 where there is none.
+// * Defined in mixSeed.cpp, so platform headers stay out of this one.
+
+
+inline std::mt19937 seedThreadEngine()
+{
+	static std::atomic<unsigned int> seeded(0);
+	std::seed_seq seq = { static_cast<unsigned int>(time(0)), seeded++,
+						  processId() };
+	return std::mt19937(seq);
+}
+// Description:
+// * Returns an rng seeded from the time, the amount of rngs seeded so far in
+// this process, and the process id.
+
+
+#endif
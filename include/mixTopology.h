@@ -0,0 +1,171 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: mixTopology.h
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Class Invariant:
+// * A mixTopology holds at least 1 node, and every node at least 1 cpu.
+// * A simulated topology splits the cpus of the host into nodes of its own
+// choosing, whatever the hardware actually looks like.
+
+// Interface Invariant:
+// * Topologies are made by detect(), simulated() or parse().
+// * pinThread() restricts the calling thread to the cpus of a node. On hosts
+// where threads can not be pinned it does nothing and returns false.
+// * runOnNode() runs a task on a thread pinned to a node, and waits for it.
+
+// DESCRIPTION:
+// * mixTopology describes which cpus belong to which NUMA node, so mixer
+// datasets can be placed on the node of the threads that ping them.
+
+// ASSUMPTIONS:
+// * Memory is placed by first touch: a page lands on the node of the thread
+// that first writes it. Seeding mixers (or reserving a datasetPool) on a
+// thread pinned to a node therefore places their datasets on that node, with
+// no NUMA library needed.
+// * detect() reads /sys/devices/system/node on Linux, and falls back to a
+// single node holding every hardware thread elsewhere.
+// * A configuration lists the cpus of each node, nodes separated by ';', cpus
+// by ',', with ranges written as "a-b" (i.e. "0-3,8-11;4-7,12-15").
+// * On a single-node host a simulated topology still pins threads and places
+// datasets, it just can not make remote access any slower than local.
+
+
+#ifndef mixTopology_INCLUDED
+#define mixTopology_INCLUDED
+
+
+#include <string>  // string
+#include <thread>  // thread
+#include <vector>  // vector
+
+
+class mixTopology
+{
+	public:
+		// Constructors
+
+		mixTopology();
+		// Description:
+		// * Creates a single node holding every hardware thread.
+
+		static mixTopology detect();
+		// Description:
+		// * Returns the topology of the host.
+
+		static mixTopology simulated(unsigned int nodeCount);
+		// Description:
+		// * Returns a topology splitting the hardware threads of the host into
+		// "nodeCount" nodes of consecutive cpus. Nodes share cpus if there are
+		// fewer hardware threads than nodes.
+		//
+		// Preconditions:
+		// * "nodeCount" should be greater than 0.
+
+		static mixTopology parse(const std::string& config,
+								 bool simulated = false);
+		// Description:
+		// * Returns the topology described by "config" (see ASSUMPTIONS).
+		// * Returns the default topology if "config" is malformed, lists no
+		// cpus, or lists a cpu past the most a cpu set can hold (CPU_SETSIZE
+		// on Linux).
+
+
+		// Functionality
+
+		bool pinThread(unsigned int node) const;
+		// Description:
+		// * Restricts the calling thread to the cpus of "node".
+		// * Returns whether the thread was pinned.
+		//
+		// Preconditions:
+		// * "node" must be < nodeCount().
+
+		static bool pinThreadToCpu(unsigned int cpu);
+		// Description:
+		// * Restricts the calling thread to "cpu".
+		// * Returns whether the thread was pinned.
+
+		template <typename Task>
+		void runOnNode(unsigned int node, Task task) const;
+		// Description:
+		// * Runs "task()" on a new thread pinned to "node", and waits for it
+		// to finish. Mixers seeded by "task" have their datasets placed on
+		// "node".
+		//
+		// Preconditions:
+		// * "node" must be < nodeCount().
+
+
+		// Accessors
+
+		unsigned int nodeCount() const;
+		// Description:
+		// * Returns the amount of nodes.
+
+		const std::vector<unsigned int>& cpus(unsigned int node) const;
+		// Description:
+		// * Returns the cpus of "node".
+
+		unsigned int cpuCount() const;
+		// Description:
+		// * Returns the amount of cpus across the nodes.
+
+		unsigned int nodeOfCpu(unsigned int index) const;  // 1
+		unsigned int cpu(unsigned int index) const;  // 2
+		// Description (1-2):
+		// * Cpus are numbered node by node, from 0 to cpuCount() - 1. Return
+		// the node (1) and id (2) of cpu number "index".
+
+		bool isSimulated() const;
+		// Description:
+		// * Returns whether the nodes are simulated.
+
+		std::string toString() const;
+		// Description:
+		// * Returns the topology as a configuration (see ASSUMPTIONS).
+
+
+	private:
+		// Members
+
+		std::vector<std::vector<unsigned int> > _nodes;
+		// Cpus of each node.
+
+		bool _simulated;
+		// Whether the nodes are simulated.
+};
+
+
+template <typename Task>
+void mixTopology::runOnNode(unsigned int node, Task task) const
+{
+	std::thread worker([this, node, &task]() {
+		pinThread(node);
+		task();
+	});
+	worker.join();
+}
+
+
+inline unsigned int mixTopology::nodeCount() const
+{
+	return _nodes.size();
+}
+
+
+inline const std::vector<unsigned int>& mixTopology::cpus(
+		unsigned int node) const
+{
+	return _nodes[node];
+}
+
+
+inline bool mixTopology::isSimulated() const
+{
+	return _simulated;
+}
+
+
+#endif
@@ -0,0 +1,100 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: mixValue.h
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// DESCRIPTION:
+// * mixValueTraits describes how the mixers treat a value type: its parity,
+// whether it is prime, and its hash.
+// * The mixers are templates over the value type (see numMixer.h), and only
+// touch values through integer arithmetic and these traits.
+
+// ASSUMPTIONS:
+// * The primary template serves every built-in integer type. Custom integer
+// types specialize mixValueTraits, and the mixers are then instantiated for
+// them at the bottom of their source files.
+// * Parity is read off the low bit, which is correct for negative values too
+// (two's complement).
+// * Values below 128 are tested against a 128-bit mask of primes, which covers
+// every value the mixers seed datasets with. Larger values are tested by the
+// width of the type: a sieve of the 16-bit range, or a deterministic
+// Miller-Rabin test for 32 and 64 bits, so 64-bit values need no table.
+// * Negative values, 0 and 1 are not prime.
+
+
+#ifndef mixValue_INCLUDED
+#define mixValue_INCLUDED
+
+
+#include <cstdint>  // uint16_t, uint32_t, uint64_t
+
+
+#include "../include/mixHash.h"
+
+
+bool isPrime16(std::uint16_t val);
+bool isPrime32(std::uint32_t val);
+bool isPrime64(std::uint64_t val);
+// Description:
+// * Return whether "val" is prime, by sieve (16 bits) or by Miller-Rabin with
+// bases that are exact for the whole width (32, 64 bits).
+
+
+template <typename T>
+struct mixValueTraits
+{
+	static bool isOdd(T val);
+	// Description:
+	// * Returns whether "val" is odd, including negative values.
+
+	static bool isPrime(T val);
+	// Description:
+	// * Returns whether "val" is prime.
+
+	static std::uint64_t hash(T val);
+	// Description:
+	// * Returns mixHash() of "val".
+};
+
+
+template <typename T>
+inline bool mixValueTraits<T>::isOdd(T val)
+{
+	return (val & 1) != 0;
+}
+
+
+template <typename T>
+inline bool mixValueTraits<T>::isPrime(T val)
+{
+	// bit n set for every prime n < 128
+	const std::uint64_t LOW_PRIMES = 0x28208a20a08a28acULL;
+	const std::uint64_t HIGH_PRIMES = 0x800228a202088288ULL;
+	if (val < 2) {
+		return false;
+	}
+	if (val < 64) {
+		return (LOW_PRIMES >> val) & 1;
+	}
+	if (val < 128) {
+		return (HIGH_PRIMES >> (val - 64)) & 1;
+	}
+	if (sizeof(T) <= 2) {
+		return isPrime16(val);
+	}
+	if (sizeof(T) <= 4) {
+		return isPrime32(val);
+	}
+	return isPrime64(val);
+}
+
+
+template <typename T>
+inline std::uint64_t mixValueTraits<T>::hash(T val)
+{
+	return mixHash(val);
+}
+
+
+#endif
@@ -26,7 +26,8 @@
 // output from them depending on their state.
 
 // ASSUMPTIONS:
-// * numMixer objects are tracked via a stack.
+// * numMixer objects are tracked via a stack, stored as a vector whose back
+// is the top of the stack.
 // * The client decides when and how many numMixers to add/remove.
 // * When a numMixer is added, it is seeded with a dataset 2-100 and then
 // pushed onto the stack.
@@ -37,9 +38,13 @@
 // top of the stack and returns an array.
 // * The state of the numMixer depends on its index in the stack.
 // * For numMixers where i % 3 = 0, the state is set to "Mix".
-// * For numMixers in state "Mix", 10 mixed elements are requested. The
-// elements are then tested against a predefined list of prime numbers < 100.
-// Prime elements are removed, and the rest are returned to the client.
+// * For numMixers in state "Mix", 10 mixed elements are requested. Prime
+// elements are then removed, as tested by the value type (see mixValue.h),
+// and the rest are returned to the client.
+// * Pings are post-processed by a mixPipeline per state (see mixPipeline.h),
+// in a single pass. "Mix" runs mixPipeline::primePurge(), which removes the
+// primes, "Even" and "Odd" run an empty pipeline. The client may set its own
+// pipeline for any state, i.e. to add filters to the prime purge.
 // * For numMixers where i % 3 = 1, the state is set to "Even".
 // For numMixers in state "Even", 10 even elements are requested and returned
 // to the client.
@@ -47,7 +52,10 @@
 // * For numMixers in state "Odd", 10 odd elements are requested and returned
 // to the client.
 // * Comparison (==) operators are supported.
-// * Comparison is performed on the stack.
+// * Comparison is performed on the stack, the schedule policy and the sorted
+// output and packed datasets modes.
+// * A fingerprint of the stack is maintained as numMixers are pushed, popped
+// and pinged, so unequal multiMixes are usually told apart in O(1).
 // * Relational (<) operators are supported.
 // * Relations are asses on the size of the stack.
 // * Addition (+) operators are supported.
@@ -56,51 +64,151 @@
 // * Mixed-mode addition is supported.
 // * A multiMix and a numMixer can be added together, in which case the numMixer
 // is pushed onto the stack.
+// * The client can reserve room for numMixers up front. Stack slots and
+// dataset buffers are then recycled through a datasetPool, so add/remove churn
+// within the reservation does no heap traffic.
+// * By default ping() pings the top of the stack (policy STACK). The client
+// may instead pick a schedule policy, in which case active numMixers are kept
+// in a priority queue and each ping goes to the one with the highest priority:
+// the most remaining countdown (COUNTDOWN), the longest wait since it joined
+// or was last pinged (ROUND_ROBIN), or the longest wait since it was last
+// pinged, never pinged first (LEAST_RECENTLY_USED).
+// * Scheduled numMixers that run out of countdown, or fail a ping, are retired
+// from the schedule. They stay on the stack. numMixers with a replenishPolicy
+// are refilled when pinged again after running out, so they stay scheduled.
+// When their policy does not grant (e.g. its tokenBucket is empty for now),
+// the ping fails but they stay scheduled, to be tried again later.
+// * Datasets are placed on the NUMA node of the thread that seeds them, so
+// numMixers added on a thread pinned to a node (see mixTopology::runOnNode())
+// live on that node.
+// * The client can have the datasets of added numMixers packed (see
+// packedDataset.h), which stores values 2-100 in 7 bits each. Packed datasets
+// are not recycled through the datasetPool.
+// * The client can turn on sorted output mode, in which ping() returns its
+// values in ascending order, counting sorted over their range (see
+// mixKernels.h).
+// * lazyPings() returns a view of a run of pings (see pingView.h), whose
+// values are those of ping() called once per block, back to back. A ping, and
+// the countdown it consumes, is only made once the view reaches its block, so
+// a consumer that stops early leaves the rest of the countdown in place.
+// * basicMultiMix<T> stacks numMixers of values of type T (see numMixer.h).
+// multiMix stacks int numMixers, multiMix16 and multiMix64 16-bit and 64-bit
+// ones. The value types are instantiated at the bottom of multiMix.cpp.
 
 
 #ifndef multiMix_INCLUDED
 #define multiMix_INCLUDED
 
 
-#include <stack>  // stack
+#include <cstddef>  // size_t
+#include <cstdint>  // int16_t, int64_t, uint32_t, uint64_t
+#include <functional>  // hash
+#include <limits>  // numeric_limits
 #include <vector>  // vector
 #include <random>  // mt19937
+#include <iterator>  // make_move_iterator
+#include <utility>  // move
 
 
+#include "../include/datasetPool.h"
+#include "../include/mixHash.h"
+#include "../include/mixPipeline.h"
+#include "../include/mixResult.h"
+#include "../include/mixValue.h"
 #include "../include/numMixer.h"
+#include "../include/packedDataset.h"
+#include "../include/pingView.h"
 
 
-class multiMix
+template <typename T>
+class basicMultiMix
 {
 	public:
+		// Types
+
+		typedef T value_type;
+		typedef basicNumMixer<T> numMixer;
+		typedef basicMixResult<T> mixResult;
+		typedef basicDatasetPool<T> datasetPool;
+		typedef basicMixPipeline<T> mixPipeline;
+		typedef basicPackedDataset<T> packedDataset;
+		typedef basicPingView<T> pingView;
+		// Values, numMixers, results, dataset pool, packed datasets and ping
+		// views of the multiMix's value type.
+
+		enum SchedulePolicy { STACK, COUNTDOWN, ROUND_ROBIN, LEAST_RECENTLY_USED };
+		// Policies ping() picks the numMixer to ping by.
+
+
 		// Constructors
 
-		multiMix();
+		basicMultiMix();
 		// Description:
 		// * Initializes the stack.
 		//
 		// Postconditions:
 		// * The stack is intiialized, starting out empty.
-
-		~multiMix();
+		// * The schedule policy is STACK.
+		// * Datasets are not packed.
+
+		basicMultiMix(const basicMultiMix& obj) = default;  // 1
+		basicMultiMix(basicMultiMix&& obj) noexcept;  // 2
+		basicMultiMix& operator=(const basicMultiMix& obj) = default;  // 3
+		basicMultiMix& operator=(basicMultiMix&& obj) noexcept;  // 4
+		// Description (1-4):
+		// * Copies/moves the stack and its schedule.
+		// * Moving transfers the numMixers without copying their datasets,
+		// and never throws, so containers of multiMixes move them as they
+		// grow.
+		// * A moved-from multiMix is left with an empty stack and schedule,
+		// and the default pipelines. Its schedule policy and output modes are
+		// kept, so it can be used, hashed and compared as any empty multiMix.
+
+
+		// Destructors
+
+		~basicMultiMix();
 		// Description:
 		// * Placeholder, no-op
 
 
 		// Functionality
 
-		std::vector<int> ping();
+		mixResult ping();
 		// Description:
-		// * Pings an object and returns a vector depending on the state of the
-		// numMixer.
+		// * Pings an object and returns a result depending on the state of the
+		// numMixer. Its 10 values are held inline, so returning it does not
+		// allocate (see mixResult.h).
 		// * The state of a numMixer depends on its position in the stack.
 		// * numMixers rotate state through "Mix -> Even -> Odd", beginning at
 		// Mix and repeating every third index.
 		// * numMixers in a "Mix" state have their prime elements removed,
 		// before they are returned to the client.
+		// * Under policy STACK, the top of the stack is pinged.
+		// * Under any other policy, the scheduled numMixer with the highest
+		// priority is pinged, in O(log n). numMixers without a
+		// replenishPolicy that are exhausted by the ping, or fail it, are
+		// retired, and a failed ping moves on to the next numMixer. A numMixer
+		// with a replenishPolicy that fails the ping stays scheduled, and an
+		// empty result is returned. An empty result is also returned once
+		// every numMixer is retired.
+		// * In sorted output mode, the values are in ascending order.
 		// 
 		// Preconditions:
-		// * The stack must contain at least 1 numMixer.
+		// * Under policy STACK, the stack must contain at least 1 numMixer.
+
+		pingView lazyPings(unsigned int count);
+		// Description:
+		// * Returns a view of the values of "count" pings, in order, each made
+		// by ping() when the view reaches it.
+		// * The view ends early once a ping would be invalid or fails: under
+		// policy STACK once the stack is empty or its top is exhausted, under
+		// any other policy once every numMixer is retired, or one with a
+		// replenishPolicy is not granted pings.
+		//
+		// Preconditions:
+		// * The multiMix must outlive the view, and not be moved while it is
+		// read.
 
 
 		// Accessors
@@ -115,13 +223,70 @@ class multiMix
 		// * Returns true if the stack does any contain numMixer objects.
 		// * Returns false if the satck does not contain any numMixer objects.
 
-		const std::stack<numMixer>& numMixerStack() const;
+		const std::vector<numMixer>& numMixerStack() const;
 		// Description:
 		// * Returns the numMixer stack.
+		// * Index 0 is the bottom of the stack, back() is the top.
+
+		SchedulePolicy schedulePolicy() const;
+		// Description:
+		// * Returns the schedule policy.
+
+		int getScheduledCount() const;
+		// Description:
+		// * Returns the amount of numMixers ping() may still pick, i.e. those
+		// in the schedule that have not been retired.
+		// * Always 0 under policy STACK.
+
+		bool packedDatasets() const;
+		// Description:
+		// * Returns whether the datasets of added numMixers are packed.
+
+		bool sortedOutput() const;
+		// Description:
+		// * Returns whether ping() returns its values sorted.
+
+		const mixPipeline& pipeline(
+			typename numMixer::OutputController state) const;
+		// Description:
+		// * Returns the pipeline pings of numMixers in state "state" are run
+		// through.
 
 
 		// Mutators
 
+		static void seed(std::uint32_t seed);
+		// Description:
+		// * Reseeds the rng of the calling thread with "seed", so the datasets
+		// seeded on this thread from now on are reproducible.
+
+		void setSchedulePolicy(SchedulePolicy policy);
+		// Description:
+		// * Switches ping() to "policy", and rebuilds the schedule from the
+		// active numMixers on the stack, in O(n log n).
+		// * Pushed numMixers join the schedule if they are active, popped
+		// numMixers leave it.
+		//
+		// Postconditions:
+		// * Every active numMixer is scheduled, unless "policy" is STACK.
+
+		void setPackedDatasets(bool packed);
+		// Description:
+		// * Sets whether the datasets of numMixers added from now on are
+		// packed. numMixers already on the stack are left as they are.
+
+		void setSortedOutput(bool sorted);
+		// Description:
+		// * Sets whether ping() returns its values sorted in ascending order.
+
+		void setPipeline(typename numMixer::OutputController state,
+						 mixPipeline pipeline);
+		// Description:
+		// * Runs pings of numMixers in state "state" through "pipeline" from
+		// now on, in place of the one set before.
+		// * Pass mixPipeline::primePurge() for state MIX to restore the
+		// default.
+
 		void addNumMixers(unsigned int count);
 		// Description:
 		// * Seeds and pushes the requested amount, "count", of numMixers to the
@@ -133,9 +298,32 @@ class multiMix
 		// Postconditions:
 		// * The stack contains "count" new numMixers.
 
+		void addNumMixersParallel(unsigned int count,
+								  unsigned int threadCount = 0);
+		// Description:
+		// * Same as addNumMixers(count), but the numMixers are seeded
+		// concurrently by "threadCount" threads. A "threadCount" of 0 uses one
+		// thread per hardware thread.
+		// * numMixers are seeded in fixed-size chunks. Each chunk draws from
+		// its own rng, seeded from a single draw of the shared rng and the
+		// chunk's index, so the result does not depend on "threadCount".
+		// * The seeded numMixers are pushed onto the stack in a single step,
+		// once every chunk is done.
+		// * Datasets are taken from the dataset pool, as addNumMixers(count)
+		// does. The buffers available are acquired up front, and handed to
+		// the first numMixers, so workers never touch the pool.
+		// 
+		// Preconditions:
+		// * "count" should be greater than 0.
+		//
+		// Postconditions:
+		// * The stack contains "count" new numMixers.
+
 		void removeNumMixers(unsigned int count);
 		// Description:
 		// * Pops the requested amount, "count", numMixers from the stack.
+		// * The datasets of popped numMixers are returned to the dataset pool,
+		// unless they are packed.
 		// 
 		// Preconditions:
 		// * "count" should be greater than 0.
@@ -144,179 +332,472 @@ class multiMix
 		// Postconditions:
 		// * The stack contains "count" less numMixers.
 
+		void reserveNumMixers(unsigned int count);
+		// Description:
+		// * Reserves stack slots for "count" more numMixers, and preallocates
+		// "count" dataset buffers in the dataset pool.
+		// * Popped numMixers give their dataset buffers back to the pool, and
+		// pushed numMixers take them from the pool, so add/remove churn within
+		// the reservation does no heap traffic.
+		//
+		// Postconditions:
+		// * The stack can grow by "count" without reallocating.
+		// * The dataset pool holds at least "count" buffers.
+
+		const datasetPool& pool() const;
+		// Description:
+		// * Returns the dataset pool.
+
+		std::size_t hash() const;
+		// Description:
+		// * Returns a fingerprint of the stack, the schedule policy and the
+		// sorted output and packed datasets modes, in O(1).
+		// * Equal multiMixes have equal fingerprints.
+
 
 		// Comparison Operators
 
-		friend bool operator==(const multiMix& lhs, const multiMix& rhs);  // 1
-		friend bool operator!=(const multiMix& lhs, const multiMix& rhs);  // 2
+		template <typename U>
+		friend bool operator==(const basicMultiMix<U>& lhs,
+							   const basicMultiMix<U>& rhs);  // 1
+		template <typename U>
+		friend bool operator!=(const basicMultiMix<U>& lhs,
+							   const basicMultiMix<U>& rhs);  // 2
 		// Description (1-2):
-		// * Checks if the contents of the stacks are the same, as well as the
-		// random number generators (i.e. will they generate the same dataset?).
-
-		friend bool operator<(const multiMix& lhs, const multiMix& rhs);  // 3
-		friend bool operator>(const multiMix& lhs, const multiMix& rhs);  // 4
-		friend bool operator<=(const multiMix& lhs, const multiMix& rhs);  // 5
-		friend bool operator>=(const multiMix& lhs, const multiMix& rhs);  // 6
+		// * Checks if the contents of the stacks, the schedule policies and
+		// the sorted output and packed datasets modes are the same, as well as
+		// the random number generators (i.e. will they generate the same
+		// dataset?).
+		// * The fingerprints are compared first, so the stacks are only
+		// compared numMixer by numMixer if they are likely equal.
+
+		template <typename U>
+		friend bool operator<(const basicMultiMix<U>& lhs,
+							  const basicMultiMix<U>& rhs);  // 3
+		template <typename U>
+		friend bool operator>(const basicMultiMix<U>& lhs,
+							  const basicMultiMix<U>& rhs);  // 4
+		template <typename U>
+		friend bool operator<=(const basicMultiMix<U>& lhs,
+							   const basicMultiMix<U>& rhs);  // 5
+		template <typename U>
+		friend bool operator>=(const basicMultiMix<U>& lhs,
+							   const basicMultiMix<U>& rhs);  // 6
 		// Description (3-6):
 		// * Compares the sizes of the stacks.
 
 
 		// Arithmetic Operators
 
-		friend multiMix operator+(multiMix lhs, const multiMix& rhs);  // 1
-		multiMix& operator+=(multiMix obj);  // 2
+		template <typename U>
+		friend basicMultiMix<U> operator+(basicMultiMix<U> lhs,
+										  const basicMultiMix<U>& rhs);  // 1
+		basicMultiMix& operator+=(basicMultiMix obj);  // 2
 		// Description (1-2):
 		// * Pushes numMixers from rhs onto lhs.
+		// * The numMixers of "obj" are moved, so passing an rvalue avoids
+		// copying them.
 		// 
 		// Postconditions:
 		// * "_numMixerStack" may have increased in size.
 
-		friend multiMix operator+(multiMix lhs, const numMixer& rhs);  // 3
-		multiMix& operator+=(const numMixer& copy);  // 4
-		// Description (3-4):
+		template <typename U>
+		friend basicMultiMix<U> operator+(basicMultiMix<U> lhs,
+										  const basicNumMixer<U>& rhs);  // 3
+		basicMultiMix& operator+=(const numMixer& obj);  // 4
+		basicMultiMix& operator+=(numMixer&& obj);  // 5
+		// Description (3-5):
 		// * Pushes rhs onto the stack.
+		// * (5) moves rhs onto the stack instead of copying it.
 		// 
 		// Postconditions:
 		// * "_numMixerStack" will have increased in size.
 
 
 	private:
+		// Types
+
+		struct scheduleEntry
+		{
+			std::uint64_t key;
+			std::size_t index;
+			std::uint64_t id;
+		};
+		// A scheduled numMixer: its priority, stack index and slot id.
+
+
 		// Utility
 
-		std::vector<int> generateDataset(unsigned int size = 30);
+		bool pingSlot(std::size_t index, mixResult& returnset);
+		// Description:
+		// * Sets the state of the numMixer at "index" from its index, pings
+		// it into "returnset" and keeps the stack fingerprint up to date.
+		// * Sorts "returnset" in sorted output mode.
+		// * Returns whether the ping succeeded.
+		//
+		// Preconditions:
+		// * "returnset" should be size > 0.
+
+		bool pingScheduled(mixResult& returnset);
+		// Description:
+		// * Pings the scheduled numMixer with the highest priority into
+		// "returnset" (see ping()), re-keying or retiring it.
+		// * Returns whether a ping succeeded. Returns false once a numMixer
+		// with a replenishPolicy fails its ping, or every numMixer is retired.
+		//
+		// Preconditions:
+		// * The schedule policy must not be STACK.
+		// * "returnset" should be size > 0.
+
+		std::vector<T> generateDataset(unsigned int size = _DATASET_SIZE);
 		// Description:
 		// * Generates a dataset of size, "size", of values 2-100.
 		// * Returns a randomly generated dataset.
+		// * The dataset buffer is taken from the dataset pool.
 		// 
 		// Preconditions:
 		// * "size" should be > 0.
 
-		bool isPrime(int n);
+		template <typename Engine>
+		static void fillDataset(std::vector<T>& dataset, Engine& eng);
 		// Description:
-		// * Tests if the passed number, "n", is prime or not by comparing to a
-		// predefined list of prime numbers < 100.
-		// * Returns true if "n" is prime.
-		// * Returns false if "n" is not prime.
-		// 
-		// Preconditions:
-		// * "n" must be 2 <= n <= 100.
+		// * Fills "dataset" with random values 2-100, drawn from "eng".
 
-		void purgePrimeNumbers(std::vector<int>& arr);
+		static const std::vector<mixPipeline>& defaultPipelines();
 		// Description:
-		// * Removes prime values from the passed vector.
-		// * Prime values are moved to the end of the vector, decrementing
-		// "newSize" each time.
-		// * Once the array has been parsed, it is resized to "newSize",
-		// discarding prime values at the end.
-		// 
+		// * Returns the pipeline of every state a new multiMix starts with:
+		// mixPipeline::primePurge() for MIX, empty ones for EVEN and ODD.
+
+		static bool schedulable(const numMixer& obj);
+		// Description:
+		// * Returns whether "obj" may still be pinged: it is active, or has a
+		// replenishPolicy to refill it at its next ping.
+
+		static std::uint64_t slotHash(std::size_t index, const numMixer& obj);
+		// Description:
+		// * Returns the hash "obj" contributes to the stack fingerprint when at
+		// index "index".
+
+		void trackSlots(std::size_t first);
+		// Description:
+		// * Adds the numMixers from index "first" to the top of the stack to
+		// the stack fingerprint, and schedules the active ones.
+		//
 		// Preconditions:
-		// * "arr" should be size > 0.
-		// * "arr" must contain integers 2-100.
+		// * The numMixers from "first" up must be untracked.
+
+		void schedule(std::size_t index, std::uint64_t lastUsed);
+		// Description:
+		// * Gives the numMixer at "index" a new slot id and pushes it onto the
+		// schedule, with the priority it has when last pinged at tick
+		// "lastUsed" (0 if never).
+
+		std::uint64_t scheduleKey(std::size_t index,
+								  std::uint64_t lastUsed) const;
+		// Description:
+		// * Returns the priority of the numMixer at "index" under the schedule
+		// policy, when last pinged at tick "lastUsed".
+
+		static bool scheduleBefore(const scheduleEntry& lhs,
+								   const scheduleEntry& rhs);
+		// Description:
+		// * Orders the schedule heap. Returns true if "lhs" has lower priority
+		// than "rhs". Ties go to the higher stack index.
+
+		void compactSchedule();
+		// Description:
+		// * Drops the entries of popped and retired numMixers from the
+		// schedule, once they outnumber the live ones.
 
 
 		// Members
 
-		static const std::vector<int> _PRIME_NUMBERS;
-		// Defines all prime numbers, n, where 2 <= n < 100.
+		static const unsigned int _DATASET_SIZE = 30;
+		// Size of the datasets numMixers are seeded with.
+
+		static const unsigned int _CHUNK_SIZE = 4096;
+		// Amount of numMixers seeded from each rng substream by
+		// addNumMixersParallel().
+
+		static thread_local std::mt19937 _eng;
+		// Rng used to seed datasets for numMixer objects. One per thread and
+		// value type, so multiMixes can be used concurrently.
+
+		std::vector<numMixer> _numMixerStack;
+		// Holds numMixes as the user adds/removes them, back() is the top.
+
+		datasetPool _datasetPool;
+		// Recycles the datasets of removed numMixers.
+
+		std::uint64_t _stackHash;
+		// Sum of slotHash() over the stack.
+
+		SchedulePolicy _schedulePolicy;
+		// Policy ping() picks the numMixer to ping by.
+
+		std::vector<scheduleEntry> _schedule;
+		// Max-heap of scheduled numMixers, by scheduleBefore(). May hold stale
+		// entries, whose id no longer matches their slot.
 
-		static std::mt19937 _eng;
-		// Rng used to seed datasets for numMixer objects.
+		std::vector<std::uint64_t> _slotIds;
+		// Slot id of every numMixer on the stack, 0 if it is not scheduled.
 
-		std::stack<numMixer> _numMixerStack;
-		// Holds numMixes as the user adds/removes them.
+		std::uint64_t _nextSlotId;
+		// Last slot id handed out.
+
+		std::uint64_t _scheduleTick;
+		// Ticks once per scheduled ping, and per numMixer joining a
+		// ROUND_ROBIN schedule.
+
+		int _scheduledCount;
+		// Amount of non-zero slot ids.
+
+		bool _packedDatasets;
+		// Whether the datasets of added numMixers are packed.
+
+		bool _sortedOutput;
+		// Whether ping() returns its values sorted.
+
+		std::vector<mixPipeline> _pipelines;
+		// Pipeline of every state, indexed by numMixer::OutputController.
+		// Empty once moved from, standing for defaultPipelines(), so moving
+		// need not allocate.
 };
 
 
-inline int multiMix::getNumMixerCount() const
+typedef basicMultiMix<int> multiMix;
+typedef basicMultiMix<std::int16_t> multiMix16;
+typedef basicMultiMix<std::int64_t> multiMix64;
+// multiMixes of int, 16-bit and 64-bit values.
+
+
+template <typename T>
+inline int basicMultiMix<T>::getNumMixerCount() const
 {
 	return _numMixerStack.size();
 }
 
 
-inline bool multiMix::hasNumMixers() const
+template <typename T>
+inline bool basicMultiMix<T>::hasNumMixers() const
 {
 	return _numMixerStack.size();
 }
 
 
-inline const std::stack<numMixer>& multiMix::numMixerStack() const
+template <typename T>
+inline const std::vector<typename basicMultiMix<T>::numMixer>&
+basicMultiMix<T>::numMixerStack() const
 {
 	return _numMixerStack;
 }
 
 
-inline bool operator==(const multiMix& lhs, const multiMix& rhs)
+template <typename T>
+inline typename basicMultiMix<T>::SchedulePolicy
+basicMultiMix<T>::schedulePolicy() const
+{
+	return _schedulePolicy;
+}
+
+
+template <typename T>
+inline int basicMultiMix<T>::getScheduledCount() const
+{
+	return _scheduledCount;
+}
+
+
+template <typename T>
+inline bool basicMultiMix<T>::packedDatasets() const
+{
+	return _packedDatasets;
+}
+
+
+template <typename T>
+inline bool basicMultiMix<T>::sortedOutput() const
+{
+	return _sortedOutput;
+}
+
+
+template <typename T>
+inline const typename basicMultiMix<T>::mixPipeline&
+basicMultiMix<T>::pipeline(typename numMixer::OutputController state) const
+{
+	return _pipelines.empty() ? defaultPipelines()[state] : _pipelines[state];
+}
+
+
+template <typename T>
+inline const typename basicMultiMix<T>::datasetPool&
+basicMultiMix<T>::pool() const
 {
-	return (lhs._numMixerStack == rhs._numMixerStack);
+	return _datasetPool;
 }
 
 
-inline bool operator!=(const multiMix& lhs, const multiMix& rhs)
+template <typename T>
+inline std::size_t basicMultiMix<T>::hash() const
+{
+	std::uint64_t h = hashCombine(_schedulePolicy, _sortedOutput);
+	h = hashCombine(h, _packedDatasets);
+	h = hashCombine(h, _numMixerStack.size());
+	return hashCombine(h, _stackHash);
+}
+
+
+template <typename T>
+inline bool basicMultiMix<T>::schedulable(const numMixer& obj)
+{
+	return obj.isActive() || obj.getReplenishPolicy();
+}
+
+
+template <typename T>
+inline std::uint64_t basicMultiMix<T>::slotHash(std::size_t index,
+												const numMixer& obj)
+{
+	return hashCombine(index, obj.hash());
+}
+
+
+template <typename T>
+inline std::uint64_t basicMultiMix<T>::scheduleKey(
+		std::size_t index,
+		std::uint64_t lastUsed) const
+{
+	if (_schedulePolicy == COUNTDOWN) {
+		return _numMixerStack[index].countDown();
+	}
+	return std::numeric_limits<std::uint64_t>::max() - lastUsed;
+}
+
+
+template <typename T>
+inline bool basicMultiMix<T>::scheduleBefore(const scheduleEntry& lhs,
+											 const scheduleEntry& rhs)
+{
+	return (lhs.key < rhs.key ||
+			(lhs.key == rhs.key && lhs.index < rhs.index));
+}
+
+
+template <typename T>
+inline bool operator==(const basicMultiMix<T>& lhs,
+					   const basicMultiMix<T>& rhs)
+{
+	return (lhs.hash() == rhs.hash() &&
+			lhs._schedulePolicy == rhs._schedulePolicy &&
+			lhs._sortedOutput == rhs._sortedOutput &&
+			lhs._packedDatasets == rhs._packedDatasets &&
+			lhs._numMixerStack == rhs._numMixerStack);
+}
+
+
+template <typename T>
+inline bool operator!=(const basicMultiMix<T>& lhs,
+					   const basicMultiMix<T>& rhs)
 {
 	return !operator==(lhs, rhs);
 }
 
 
-inline bool operator<(const multiMix& lhs, const multiMix& rhs)
+template <typename T>
+inline bool operator<(const basicMultiMix<T>& lhs,
+					  const basicMultiMix<T>& rhs)
 {
 	return (lhs._numMixerStack.size() < rhs._numMixerStack.size());
 }
 
 
-inline bool operator>(const multiMix& lhs, const multiMix& rhs)
+template <typename T>
+inline bool operator>(const basicMultiMix<T>& lhs,
+					  const basicMultiMix<T>& rhs)
 {
 	return operator<(rhs, lhs);
 }
 
 
-inline bool operator<=(const multiMix& lhs, const multiMix& rhs)
+template <typename T>
+inline bool operator<=(const basicMultiMix<T>& lhs,
+					   const basicMultiMix<T>& rhs)
 {
 	return !operator>(lhs, rhs);
 }
 
 
-inline bool operator>=(const multiMix& lhs, const multiMix& rhs)
+template <typename T>
+inline bool operator>=(const basicMultiMix<T>& lhs,
+					   const basicMultiMix<T>& rhs)
 {
 	return !operator<(lhs, rhs);
 }
 
 
-inline multiMix operator+(multiMix lhs, const multiMix& rhs)
+template <typename T>
+inline basicMultiMix<T> operator+(basicMultiMix<T> lhs,
+								  const basicMultiMix<T>& rhs)
 {
 	lhs += rhs;
 	return lhs;
 }
 
 
-inline multiMix& multiMix::operator+=(multiMix copy)
+template <typename T>
+inline basicMultiMix<T>& basicMultiMix<T>::operator+=(basicMultiMix obj)
 {
-	// invert stack
-	std::stack<numMixer> invStack;
-	while (!copy._numMixerStack.empty()) {
-		invStack.push(copy._numMixerStack.top());
-		copy._numMixerStack.pop();
-	}
-	// stack the stacks
-	while (!invStack.empty()) {
-		_numMixerStack.push(invStack.top());
-		invStack.pop();
-	}
+	// stack the stacks, bottom to top
+	std::size_t first = _numMixerStack.size();
+	_numMixerStack.insert(_numMixerStack.end(),
+			std::make_move_iterator(obj._numMixerStack.begin()),
+			std::make_move_iterator(obj._numMixerStack.end()));
+	trackSlots(first);
 	return *this;
 }
 
 
-inline multiMix operator+(multiMix lhs, const numMixer& rhs)
+template <typename T>
+inline basicMultiMix<T> operator+(basicMultiMix<T> lhs,
+								  const basicNumMixer<T>& rhs)
 {
 	lhs += rhs;
 	return lhs;
 }
 
 
-inline multiMix& multiMix::operator+=(const numMixer& obj)
+template <typename T>
+inline basicMultiMix<T>& basicMultiMix<T>::operator+=(const numMixer& obj)
 {
-	_numMixerStack.push(obj);
+	_numMixerStack.push_back(obj);
+	trackSlots(_numMixerStack.size() - 1);
 	return *this;
 }
 
 
+template <typename T>
+inline basicMultiMix<T>& basicMultiMix<T>::operator+=(numMixer&& obj)
+{
+	_numMixerStack.push_back(std::move(obj));
+	trackSlots(_numMixerStack.size() - 1);
+	return *this;
+}
+
+
+namespace std
+{
+	template <typename T>
+	struct hash<basicMultiMix<T> >
+	{
+		std::size_t operator()(const basicMultiMix<T>& obj) const
+		{
+			return obj.hash();
+		}
+	};
+}
+// Description:
+// * Lets multiMixes be used as keys in unordered containers.
+
+
 #endif
\ No newline at end of file
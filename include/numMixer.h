@@ -40,38 +40,113 @@
 // which returns true when the counter > 0.
 // * Comparison (==) operators are supported.
 // * Comparison is performed on all data members.
+// * A fingerprint of all data members is maintained, so unequal numMixers are
+// usually told apart in O(1), and the dataset is only compared element by
+// element when the fingerprints match.
 // * Relational (<) operators are supported.
 // * Relations are assessed on the countdown.
 // * Addition (+) operators are supported.
 // * Addition is performed on all members except the state controller.
 // * The dataset of the right hand side is appended to the end of the left
 // hand side.
+// * The dataset can be changed in place through insert(), erase() and
+// replace(). The order of the dataset is not significant to pings, so these
+// run in O(1) and may reorder the dataset.
+// * The amount of even and odd values in the dataset is tracked exactly, so
+// parity validity is always up to date with the dataset.
+// * A replenishPolicy can be attached, from which the countdown is refilled
+// when the numMixer is pinged after running out, so it need not go
+// permanently inactive. Pings are drawn from the policy only when needed, so
+// a numMixer that is never pinged again does not hold on to any.
+// Copies share the policy of the original. The policy is not compared or
+// hashed.
+// * A randomReservoir can be attached, from which pings draw pre-generated
+// rng output instead of running the rng. Copies share the reservoir of the
+// original. The reservoir is not compared or hashed.
+// * basicNumMixer<T> holds values of any integer type T with mixValueTraits
+// (see mixValue.h). numMixer holds ints, numMixer16 and numMixer64 hold
+// 16-bit and 64-bit values. Narrower values make for a denser dataset.
+// * The value types are instantiated at the bottom of numMixer.cpp, where
+// other value types can be added.
+// * The dataset can be an implicit arithmetic range (start, count, stride)
+// instead of a vector. An implicit dataset takes no memory. Its values are
+// computed from their index, and pings of a parity draw straight from the
+// indexes holding that parity, so they never retry.
+// The default constructor makes the range 1-100 this way.
+// * An implicit dataset behaves exactly like the same values in a vector:
+// it compares, hashes and adds the same. Adding a range that continues an
+// implicit dataset keeps it implicit. Adding anything else, or changing the
+// dataset through insert(), erase(), replace() or releaseDataset(), first
+// turns it into a vector.
+// * The fingerprint of an implicit dataset is computed when it is built, in
+// O(count), so hashing and comparing stay const and thread safe.
+// * A dataset held in a vector can be packed (see packedDataset.h), storing
+// each value as an offset from the smallest in as few bits as the values
+// need. Pings read packed values in O(1). Pings of at least as many values as
+// the dataset holds unpack it once instead, with a vectorized kernel. Like an
+// implicit dataset, a packed one behaves exactly like its vector, and turns
+// back into one when added to or changed in place.
+// * lazyPing() returns a view of a ping (see pingView.h), drawn in blocks as
+// it is read. The view consumes one unit of countdown, as ping() does, when
+// its first block is drawn, and fails (is empty) where ping() would fail.
 
 
 #ifndef numMixer_INCLUDED
 #define numMixer_INCLUDED
 
 
+#include <cstddef>  // size_t
+#include <cstdint>  // int16_t, int64_t, uint32_t, uint64_t
+#include <functional>  // hash
+#include <memory>  // shared_ptr
 #include <vector>  // vector
 #include <random>  // mt19937
 #include <string>  // string
+#include <utility>  // move
 
 
-class numMixer
+#include "../include/mixHash.h"
+#include "../include/mixValue.h"
+#include "../include/packedDataset.h"
+#include "../include/pingView.h"
+#include "../include/randomReservoir.h"
+#include "../include/replenishPolicy.h"
+
+
+template <typename T>
+class basicNumMixer
 {
 	public:
 		// Types
 
+		typedef T value_type;
+		// Type of the values in the dataset.
+
+		typedef basicPingView<T> pingView;
+		// Lazy view of a ping.
+
 		enum OutputController { MIX, EVEN, ODD };
 		// Valid states the output controller can be set to.
 
+		struct range
+		{
+			T start;
+			unsigned int count;
+			T stride;
+		};
+		// An arithmetic range of "count" values: "start", "start" + "stride",
+		// "start" + 2 * "stride", ...
+
+		typedef basicPackedDataset<T> packedDataset;
+		// Packed dataset of the numMixer's value type.
+
 
 		// Constructors
 
-		numMixer();
+		basicNumMixer();
 		// Description:
 		// * The no-arg constructor creates a dataset to choose from of values
-		// 1-100.
+		// 1-100, as an implicit range.
 		// * Calls for integers of any parity are valid.
 		// * The numMixer can be called a randomly selected amount of times,
 		// 10-20.
@@ -85,9 +160,11 @@ class numMixer
 		// * Calls for integers of even parity are valid.
 		// * Calls for integers of odd parity are valid.
 
-		explicit numMixer(std::vector<int> dataset);
+		explicit basicNumMixer(std::vector<T> dataset);
 		// Description:
 		// * This constructor creates a dataset using "dataset".
+		// * "dataset" is moved into the numMixer, so passing an rvalue avoids
+		// copying it.
 		// * The validity of various parity calls are evaluated on the dataset
 		// provided.
 		// * The numMixer can be called a randomly selected amount of times,
@@ -107,17 +184,61 @@ class numMixer
 		// * Calls for integers of even parity may or may not be valid.
 		// * Calls for integers of odd parity may or may not be valid.
 
+		basicNumMixer(std::vector<T> dataset, std::mt19937& eng);
+		// Description:
+		// * Same as numMixer(dataset), except the countdown is drawn from "eng"
+		// instead of the shared rng.
+		// * Lets numMixers be constructed concurrently, each thread drawing
+		// from its own rng.
+		//
+		// Preconditions:
+		// * Same as numMixer(dataset).
+		//
+		// Postconditions:
+		// * Same as numMixer(dataset).
+
+		explicit basicNumMixer(const range& dataset);  // 1
+		basicNumMixer(const range& dataset, std::mt19937& eng);  // 2
+		// Description (1-2):
+		// * Same as numMixer(dataset) (1) and numMixer(dataset, eng) (2), but
+		// the dataset is the implicit range "dataset". Takes no memory for
+		// the dataset, and runs in O(count) to hash it.
+		//
+		// Preconditions:
+		// * "dataset.count" must be > 0.
+		// * Every value of "dataset" must be representable in T.
+
+		explicit basicNumMixer(packedDataset dataset);  // 1
+		basicNumMixer(packedDataset dataset, std::mt19937& eng);  // 2
+		// Description (1-2):
+		// * Same as numMixer(dataset) (1) and numMixer(dataset, eng) (2), but
+		// the dataset is the packed "dataset".
+		//
+		// Preconditions:
+		// * "dataset" must not be empty.
 
-		// Constructors
 
-		virtual ~numMixer();
+		basicNumMixer(const basicNumMixer& obj) = default;  // 1
+		basicNumMixer(basicNumMixer&& obj) = default;  // 2
+		basicNumMixer& operator=(const basicNumMixer& obj) = default;  // 3
+		basicNumMixer& operator=(basicNumMixer&& obj) = default;  // 4
+		// Description (1-4):
+		// * Copies/moves all data members.
+		// * A moved-from numMixer may only be assigned to or destroyed.
+		// * Declared explicitly, since the virtual destructor would otherwise
+		// suppress the implicit move operations.
+
+
+		// Destructors
+
+		virtual ~basicNumMixer();
 		// Description:
 		// * Currently just a placeholder, does nothing.
 
 
 		// Functionality
 
-		virtual bool ping(std::vector<int>& returnValues);
+		virtual bool ping(std::vector<T>& returnValues);
 		// Description:
 		// * Stores a random selection of integers from the dataset into
 		// "returnValues".
@@ -135,9 +256,41 @@ class numMixer
 		// * The user must have provided integers of the requested parity at
 		// object creation.
 		//
+		// * If a replenishPolicy is attached, an exhausted countdown is refilled
+		// from it at the next ping, so pings are only granted to numMixers
+		// that are pinged again.
+		//
 		// Postconditions:
 		// * If the call succeeds, the countdown is decremented.
 
+		virtual bool ping(T* returnValues, unsigned int size);
+		// Description:
+		// * Same as ping(returnValues), but stores "size" integers straight
+		// into the caller's buffer "returnValues".
+		// * "returnValues" is left untouched if the call fails.
+		//
+		// Preconditions:
+		// * Same as ping(returnValues).
+		// * "returnValues" must have room for "size" integers.
+		//
+		// Postconditions:
+		// * Same as ping(returnValues).
+
+		pingView lazyPing(unsigned int size);
+		// Description:
+		// * Returns a view of a ping of "size" integers, drawn in blocks as
+		// they are read, so reading the first few costs a block, not "size".
+		// * The countdown is consumed, and validity checked, when the first
+		// block is drawn. The view is empty where ping(returnValues) would
+		// fail.
+		// * The view ends early if, by the time a later block is drawn, the
+		// dataset holds no values of the requested parity.
+		//
+		// Preconditions:
+		// * Same as ping(returnValues), when the first block is drawn.
+		// * The numMixer must outlive the view, and not be moved while it is
+		// read.
+
 
 		// Accessors
 
@@ -155,9 +308,9 @@ class numMixer
 		// Description:
 		// * Returns the countdown.
 
-		std::mt19937 eng() const;
+		const std::mt19937& eng() const;
 		// Description:
-		// * Returns the rng.
+		// * Returns the rng of the calling thread.
 
 		bool evenValid() const;
 		// Description:
@@ -167,18 +320,69 @@ class numMixer
 		// Description:
 		// * Returns whether pings for odd numbers are valid.
 
-		const std::vector<int>& dataset() const;
+		unsigned int evenCount() const;
+		// Description:
+		// * Returns the amount of even values in the dataset.
+
+		unsigned int oddCount() const;
+		// Description:
+		// * Returns the amount of odd values in the dataset.
+
+		std::vector<T> dataset() const;
+		// Description:
+		// * Returns a copy of the dataset, generated if it is implicit.
+
+		unsigned int datasetSize() const;
+		// Description:
+		// * Returns the amount of values in the dataset.
+
+		T datasetValue(unsigned int index) const;
+		// Description:
+		// * Returns the value at "index" of the dataset.
+		//
+		// Preconditions:
+		// * "index" must be less than datasetSize().
+
+		bool isImplicit() const;
+		// Description:
+		// * Returns whether the dataset is an implicit range.
+
+		const range& implicitRange() const;
+		// Description:
+		// * Returns the implicit range of the dataset, with a count of 0 if the
+		// dataset is not implicit.
+
+		bool isPacked() const;
+		// Description:
+		// * Returns whether the dataset is packed.
+
+		const packedDataset& packed() const;
 		// Description:
-		// * Returns the dataset.
+		// * Returns the packed dataset, empty if the dataset is not packed.
 
 		OutputController getControllerState() const;
 		// Description:
 		// * Returns the state of the OutputController.
 
+		const std::shared_ptr<replenishPolicy>& getReplenishPolicy() const;
+		// Description:
+		// * Returns the replenishPolicy, null if none is attached.
+
+		const std::shared_ptr<randomReservoir>& getReservoir() const;
+		// Description:
+		// * Returns the randomReservoir, null if none is attached.
+
 		std::string getControllerStateName() const;
 		// Description:
 		// * Returns the name of the controller state, for templating purposes.
 
+		std::size_t hash() const;
+		// Description:
+		// * Returns a fingerprint of all data members, in O(1).
+		// * Equal numMixers have equal fingerprints.
+		// * The dataset is hashed as a multiset, and the hash is updated
+		// incrementally as the dataset changes.
+
 
 		// Mutators
 
@@ -193,48 +397,202 @@ class numMixer
 		// Postconditions:
 		// * The output controller changes state.
 
+		void setReplenishPolicy(std::shared_ptr<replenishPolicy> policy);
+		// Description:
+		// * Attaches "policy", from which the countdown is refilled whenever it
+		// runs out. A null "policy" detaches the current one.
+		// * The same policy can be attached to many numMixers, which then share
+		// its pings.
+
+		static void seed(std::uint32_t seed);
+		// Description:
+		// * Reseeds the rng of the calling thread with "seed", so the
+		// countdowns and pings that follow on this thread are reproducible.
+
+		void setReservoir(std::shared_ptr<randomReservoir> reservoir);
+		// Description:
+		// * Attaches "reservoir", which pings then draw from in place of the
+		// rng. A null "reservoir" detaches the current one.
+		//
+		// Preconditions:
+		// * "reservoir" must only be drawn from by one thread at a time.
+
+		void insert(T val);
+		// Description:
+		// * Appends "val" to the dataset, in O(1) amortized.
+		//
+		// Postconditions:
+		// * The dataset contains "val".
+		// * The even/odd counts and fingerprint are updated.
+
+		void erase(unsigned int index);
+		// Description:
+		// * Removes the value at "index" from the dataset, in O(1).
+		// * The last value of the dataset is moved into "index".
+		//
+		// Preconditions:
+		// * "index" must be less than the size of the dataset.
+		// * Erasing the last value places the numMixer in an illegal state.
+		//
+		// Postconditions:
+		// * The dataset is one value smaller.
+		// * The even/odd counts and fingerprint are updated.
+
+		void replace(unsigned int index, T val);
+		// Description:
+		// * Replaces the value at "index" with "val", in O(1).
+		//
+		// Preconditions:
+		// * "index" must be less than the size of the dataset.
+		//
+		// Postconditions:
+		// * The even/odd counts and fingerprint are updated.
+
+		bool pack();
+		// Description:
+		// * Packs a dataset held in a vector, and frees the vector.
+		// * Returns whether the dataset is packed. Implicit datasets, and
+		// datasets too wide to pack (see packedDataset::packable()), are left
+		// as they are.
+
+		std::vector<T> releaseDataset();
+		// Description:
+		// * Moves the dataset out of the numMixer and returns it, so its buffer
+		// can be reused (i.e. by a datasetPool).
+		//
+		// * An implicit or packed dataset is generated into the returned
+		// vector.
+		//
+		// Postconditions:
+		// * The dataset is empty, placing the numMixer in an illegal state. It
+		// should be discarded.
+		// * Calls for integers of even/odd parity are invalid.
+
 
 		// Comparison Operators
 
-		friend bool operator==(const numMixer& lhs, const numMixer& rhs);  // 1
-		friend bool operator!=(const numMixer& lhs, const numMixer& rhs);  // 2
+		template <typename U>
+		friend bool operator==(const basicNumMixer<U>& lhs,
+							   const basicNumMixer<U>& rhs);  // 1
+		template <typename U>
+		friend bool operator!=(const basicNumMixer<U>& lhs,
+							   const basicNumMixer<U>& rhs);  // 2
 		// Description (1-2):
 		// * Performs equality checks on all data members.
-
-		friend bool operator<(const numMixer& lhs, const numMixer& rhs);  // 3
-		friend bool operator>(const numMixer& lhs, const numMixer& rhs);  // 4
-		friend bool operator<=(const numMixer& lhs, const numMixer& rhs);  // 5
-		friend bool operator>=(const numMixer& lhs, const numMixer& rhs);  // 6
+		// * The dataset fingerprints are compared before the datasets, so
+		// datasets are only compared element by element if they are likely
+		// equal.
+
+		template <typename U>
+		friend bool operator<(const basicNumMixer<U>& lhs,
+							  const basicNumMixer<U>& rhs);  // 3
+		template <typename U>
+		friend bool operator>(const basicNumMixer<U>& lhs,
+							  const basicNumMixer<U>& rhs);  // 4
+		template <typename U>
+		friend bool operator<=(const basicNumMixer<U>& lhs,
+							   const basicNumMixer<U>& rhs);  // 5
+		template <typename U>
+		friend bool operator>=(const basicNumMixer<U>& lhs,
+							   const basicNumMixer<U>& rhs);  // 6
 		// Description (3-6):
 		// * Performs a relational check on the countdown.
 
 		// Arithmetic Operators
 
-		friend numMixer operator+(numMixer lhs, const numMixer& rhs);  // 1
-		numMixer& operator+=(const numMixer& obj);  // 2
+		template <typename U>
+		friend basicNumMixer<U> operator+(basicNumMixer<U> lhs,
+										  const basicNumMixer<U>& rhs);  // 1
+		basicNumMixer& operator+=(const basicNumMixer& obj);  // 2
 		// Description (1-2):
 		// * Adds all data members together except for the controller state.
 		// * Appends rhs._dataset onto the end of _dataset.
+		// * If both datasets are implicit and rhs continues lhs with the same
+		// stride, the result stays implicit. Otherwise lhs is turned into a
+		// vector first.
+		// * A packed lhs is turned into a vector first.
 		// 
 		// Postconditions:
 		// * _stateChangeCount may have changed.
 		// * _countDown may have changed.
-		// * _evenValid may have changed.
-		// * _oddValid may have changed.
+		// * _evenCount may have changed.
+		// * _oddCount may have changed.
 		// * _dataset may have changed.
 
 
 	protected:
 		// Utility
 
-		int genRandNum();
+		bool claimPing();
+		// Description:
+		// * Consumes one unit of countdown for a ping, replenishing an
+		// exhausted countdown first, as ping(returnValues) does.
+		// * Returns false, consuming nothing, if the numMixer is inactive or
+		// holds no values of the requested parity.
+
+		void drawValues(T* returnValues, unsigned int size);
+		// Description:
+		// * Stores "size" values into "returnValues", drawn from the reservoir
+		// if one is attached, or else from the rng. Consumes no countdown.
+		//
+		// Preconditions:
+		// * Same as genRandNum(eng).
+
+		template <typename Engine>
+		T genRandNum(Engine& eng);
 		// Description:
 		// * Selects random values from the dataset and returns them depending
 		// on the state of the output controller.
+		// * Random indexes are drawn from "eng", the rng or the reservoir.
 		//
 		// Preconditions:
 		// * The dataset must be of size > 0.
 		// * The dataset must contain numbers of the requested parity.
+
+		template <typename Engine>
+		void genRandNums(T* returnValues, unsigned int size, Engine& eng);
+		// Description:
+		// * Stores "size" values from genRandNum(eng) into "returnValues".
+		// * A packed dataset is unpacked once up front if "size" is at least
+		// its size, and values are drawn from the unpacked copy.
+		//
+		// Preconditions:
+		// * Same as genRandNum(eng).
+
+		template <typename Engine, typename Values>
+		T pickValue(const Values& values, unsigned int count, Engine& eng);
+		// Description:
+		// * Same as genRandNum(eng), over the "count" values of "values", a
+		// pointer or a packedDataset.
+
+		template <typename Engine>
+		T genRangeNum(Engine& eng);
+		// Description:
+		// * Same as genRandNum(eng), for an implicit dataset. Indexes are drawn
+		// only among the values of the requested parity.
+
+		T rangeValue(unsigned int index) const;
+		// Description:
+		// * Returns the value at "index" of the implicit range.
+
+		void materialize();
+		// Description:
+		// * Turns an implicit or packed dataset into a vector holding the same
+		// values. Does nothing if the dataset is already a vector.
+
+		std::uint64_t datasetHash() const;
+		// Description:
+		// * Returns the multiset hash of the dataset.
+
+		bool equalDataset(const basicNumMixer& obj) const;
+		// Description:
+		// * Returns whether the dataset holds the same values as that of "obj",
+		// in the same order.
+
+		bool continuesRange(const basicNumMixer& obj) const;
+		// Description:
+		// * Returns whether both datasets are implicit, and the range of "obj"
+		// carries on where this one ends, with the same stride.
 		
 		bool checkStateValid() const;
 		// Description:
@@ -243,6 +601,21 @@ class numMixer
 		// * Returns true if the call is valid.
 		// * Returns false if the call is invalid.
 
+		static bool isOdd(T val);
+		// Description:
+		// * Returns whether "val" is odd, including negative values (see
+		// mixValueTraits).
+
+		void countValue(T val, int sign);
+		// Description:
+		// * Adds ("sign" = 1) or removes ("sign" = -1) "val" from the even/odd
+		// counts and the dataset fingerprint.
+
+		void replenish();
+		// Description:
+		// * Adds the pings granted by the replenishPolicy, if any, to the
+		// countdown.
+
 
 		// Members
 
@@ -256,130 +629,376 @@ class numMixer
 	private:
 		// Members
 
-		static std::mt19937 _eng;
+		static thread_local std::mt19937 _eng;
 		// Used to seed the dataset, countDown, and randomly select values from
-		// the dataset.
+		// the dataset. One per thread and value type, so numMixers can be
+		// pinged concurrently.
+
+		unsigned int _evenCount;
+		// Amount of even values in the dataset. Pings for even values can be
+		// evaluated while > 0.
+
+		unsigned int _oddCount;
+		// Amount of odd values in the dataset. Pings for odd values can be
+		// evaluated while > 0.
 
-		bool _evenValid;
-		// Determines whether pings for even values can be evaluated.
+		std::vector<T> _dataset;
+		// Stores the values to be randomly returned in pings. Empty while the
+		// dataset is implicit or packed.
 
-		bool _oddValid;
-		// Determines whether pings for odd values can be evaluated.
+		range _range;
+		// Implicit dataset, with a count of 0 while the dataset is not
+		// implicit.
 
-		std::vector<int> _dataset;
-		// Stores the values to be randomly returned in pings.
+		packedDataset _packed;
+		// Packed dataset, empty while the dataset is not packed.
+
+		std::uint64_t _datasetHash;
+		// Multiset hash of the dataset, the sum of mixHash() of its values.
 
 		OutputController _controllerState;
 		// Determines the parity of the integers to be returned.
+
+		std::shared_ptr<replenishPolicy> _replenishPolicy;
+		// Refills "_countDown" when it runs out, may be null.
+
+		std::shared_ptr<randomReservoir> _reservoir;
+		// Pre-generated rng output pings draw from, may be null.
 };
 
 
-inline bool numMixer::isActive() const
+typedef basicNumMixer<int> numMixer;
+typedef basicNumMixer<std::int16_t> numMixer16;
+typedef basicNumMixer<std::int64_t> numMixer64;
+// numMixers of int, 16-bit and 64-bit values.
+
+
+template <typename T>
+inline bool basicNumMixer<T>::isActive() const
 {
 	return (_countDown > 0);
 }
 
 
-inline int numMixer::stateChangeCount() const
+template <typename T>
+inline int basicNumMixer<T>::stateChangeCount() const
 {
 	return _stateChangeCount;
 }
 
 
-inline int numMixer::countDown() const
+template <typename T>
+inline int basicNumMixer<T>::countDown() const
 {
 	return _countDown;
 }
 
 
-inline std::mt19937 numMixer::eng() const
+template <typename T>
+inline const std::shared_ptr<replenishPolicy>&
+basicNumMixer<T>::getReplenishPolicy() const
+{
+	return _replenishPolicy;
+}
+
+
+template <typename T>
+inline const std::shared_ptr<randomReservoir>&
+basicNumMixer<T>::getReservoir() const
+{
+	return _reservoir;
+}
+
+
+template <typename T>
+inline const std::mt19937& basicNumMixer<T>::eng() const
 {
 	return _eng;
 }
 
 
-inline bool numMixer::evenValid() const
+template <typename T>
+inline bool basicNumMixer<T>::evenValid() const
 {
-	return _evenValid;
+	return (_evenCount > 0);
 }
 
 
-inline bool numMixer::oddValid() const
+template <typename T>
+inline bool basicNumMixer<T>::oddValid() const
 {
-	return _oddValid;
+	return (_oddCount > 0);
 }
 
 
-inline const std::vector<int>& numMixer::dataset() const
+template <typename T>
+inline unsigned int basicNumMixer<T>::evenCount() const
 {
-	return _dataset;
+	return _evenCount;
 }
 
 
-inline numMixer::OutputController numMixer::getControllerState() const
+template <typename T>
+inline unsigned int basicNumMixer<T>::oddCount() const
+{
+	return _oddCount;
+}
+
+
+template <typename T>
+inline unsigned int basicNumMixer<T>::datasetSize() const
+{
+	if (_range.count) {
+		return _range.count;
+	}
+	return _packed.empty() ? _dataset.size() : _packed.size();
+}
+
+
+template <typename T>
+inline T basicNumMixer<T>::datasetValue(unsigned int index) const
+{
+	if (_range.count) {
+		return rangeValue(index);
+	}
+	return _packed.empty() ? _dataset[index] : _packed[index];
+}
+
+
+template <typename T>
+inline bool basicNumMixer<T>::isImplicit() const
+{
+	return _range.count > 0;
+}
+
+
+template <typename T>
+inline const typename basicNumMixer<T>::range&
+basicNumMixer<T>::implicitRange() const
+{
+	return _range;
+}
+
+
+template <typename T>
+inline bool basicNumMixer<T>::isPacked() const
+{
+	return !_packed.empty();
+}
+
+
+template <typename T>
+inline const typename basicNumMixer<T>::packedDataset&
+basicNumMixer<T>::packed() const
+{
+	return _packed;
+}
+
+
+template <typename T>
+inline typename basicNumMixer<T>::OutputController
+basicNumMixer<T>::getControllerState() const
 {
 	return _controllerState;
 }
 
 
-inline bool operator==(const numMixer& lhs, const numMixer& rhs)
+template <typename T>
+inline void basicNumMixer<T>::insert(T val)
+{
+	materialize();
+	_dataset.push_back(val);
+	countValue(val, 1);
+}
+
+
+template <typename T>
+inline void basicNumMixer<T>::erase(unsigned int index)
+{
+	materialize();
+	countValue(_dataset[index], -1);
+	_dataset[index] = _dataset.back();
+	_dataset.pop_back();
+}
+
+
+template <typename T>
+inline void basicNumMixer<T>::replace(unsigned int index, T val)
+{
+	materialize();
+	countValue(_dataset[index], -1);
+	_dataset[index] = val;
+	countValue(val, 1);
+}
+
+
+template <typename T>
+inline std::vector<T> basicNumMixer<T>::releaseDataset()
+{
+	materialize();
+	_evenCount = 0;
+	_oddCount = 0;
+	_datasetHash = 0;
+	std::vector<T> dataset(std::move(_dataset));
+	_dataset.clear();
+	return dataset;
+}
+
+
+template <typename T>
+inline std::size_t basicNumMixer<T>::hash() const
+{
+	std::uint64_t h = datasetHash();
+	h = hashCombine(h, datasetSize());
+	h = hashCombine(h, _stateChangeCount);
+	h = hashCombine(h, _countDown);
+	h = hashCombine(h, _evenCount);
+	h = hashCombine(h, _controllerState);
+	return h;
+}
+
+
+template <typename T>
+inline T basicNumMixer<T>::rangeValue(unsigned int index) const
+{
+	// unsigned arithmetic wraps instead of overflowing
+	return static_cast<T>(static_cast<std::uint64_t>(_range.start) +
+						  static_cast<std::uint64_t>(index) *
+						  static_cast<std::uint64_t>(_range.stride));
+}
+
+
+template <typename T>
+inline std::uint64_t basicNumMixer<T>::datasetHash() const
+{
+	return _datasetHash;
+}
+
+
+template <typename T>
+inline bool basicNumMixer<T>::isOdd(T val)
+{
+	return mixValueTraits<T>::isOdd(val);
+}
+
+
+template <typename T>
+inline void basicNumMixer<T>::countValue(T val, int sign)
+{
+	if (isOdd(val)) {
+		_oddCount += sign;
+	} else {
+		_evenCount += sign;
+	}
+	_datasetHash += sign * mixValueTraits<T>::hash(val);
+}
+
+
+template <typename T>
+inline bool operator==(const basicNumMixer<T>& lhs,
+					   const basicNumMixer<T>& rhs)
 {
 	return (lhs._stateChangeCount == rhs._stateChangeCount &&
 			lhs._countDown == rhs._countDown &&
-			lhs._evenValid == rhs._evenValid &&
-			lhs._oddValid == rhs._oddValid &&
-			lhs._dataset == rhs._dataset &&
-			lhs._controllerState == rhs._controllerState);
+			lhs._evenCount == rhs._evenCount &&
+			lhs._oddCount == rhs._oddCount &&
+			lhs._controllerState == rhs._controllerState &&
+			lhs.equalDataset(rhs));
 }
 
 
-inline bool operator!=(const numMixer& lhs, const numMixer& rhs)
+template <typename T>
+inline bool operator!=(const basicNumMixer<T>& lhs,
+					   const basicNumMixer<T>& rhs)
 {
 	return !operator==(lhs, rhs);
 }
 
 
-inline bool operator<(const numMixer& lhs, const numMixer& rhs)
+template <typename T>
+inline bool operator<(const basicNumMixer<T>& lhs,
+					  const basicNumMixer<T>& rhs)
 {
 	return (lhs._countDown < rhs._countDown);
 }
 
 
-inline bool operator>(const numMixer& lhs, const numMixer& rhs)
+template <typename T>
+inline bool operator>(const basicNumMixer<T>& lhs,
+					  const basicNumMixer<T>& rhs)
 {
 	return operator<(rhs, lhs);
 }
 
 
-inline bool operator<=(const numMixer& lhs, const numMixer& rhs)
+template <typename T>
+inline bool operator<=(const basicNumMixer<T>& lhs,
+					   const basicNumMixer<T>& rhs)
 {
 	return !operator>(lhs, rhs);
 }
 
 
-inline bool operator>=(const numMixer& lhs, const numMixer& rhs)
+template <typename T>
+inline bool operator>=(const basicNumMixer<T>& lhs,
+					   const basicNumMixer<T>& rhs)
 {
 	return !operator<(lhs, rhs);
 }
 
 
-inline numMixer operator+(numMixer lhs, const numMixer& rhs)
+template <typename T>
+inline basicNumMixer<T> operator+(basicNumMixer<T> lhs,
+								  const basicNumMixer<T>& rhs)
 {
 	lhs += rhs;
 	return lhs;
 }
 
 
-inline numMixer& numMixer::operator+=(const numMixer& obj)
+template <typename T>
+inline basicNumMixer<T>& basicNumMixer<T>::operator+=(
+		const basicNumMixer& obj)
 {
 	_stateChangeCount += obj._stateChangeCount;
 	_countDown += obj._countDown;
-	_evenValid = (_evenValid || obj._evenValid);
-	_oddValid = (_oddValid || obj._oddValid);
-	_dataset.insert(_dataset.end(), obj._dataset.begin(), obj._dataset.end());
-	_dataset.shrink_to_fit();
+	_evenCount += obj._evenCount;
+	_oddCount += obj._oddCount;
+	if (continuesRange(obj)) {
+		_range.count += obj._range.count;
+		_datasetHash += obj._datasetHash;
+		return *this;
+	}
+	std::uint64_t objHash = obj.datasetHash();
+	materialize();
+	if (obj._range.count || !obj._packed.empty()) {
+		const unsigned int SIZE = obj.datasetSize();
+		_dataset.reserve(_dataset.size() + SIZE);
+		for (unsigned int i = 0; i < SIZE; ++i) {
+			_dataset.push_back(obj.datasetValue(i));
+		}
+	} else {
+		_dataset.insert(_dataset.end(), obj._dataset.begin(),
+						obj._dataset.end());
+	}
+	_datasetHash += objHash;
 	return *this;
 }
 
 
+namespace std
+{
+	template <typename T>
+	struct hash<basicNumMixer<T> >
+	{
+		std::size_t operator()(const basicNumMixer<T>& obj) const
+		{
+			return obj.hash();
+		}
+	};
+}
+// Description:
+// * Lets numMixers be used as keys in unordered containers.
+
+
 #endif
\ No newline at end of file
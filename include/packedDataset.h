@@ -0,0 +1,264 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: packedDataset.h
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Class Invariant:
+// * A packedDataset holds its values as offsets from a base (frame of
+// reference), the smallest value, each stored in the same amount of bits,
+// just enough for the largest offset.
+// * The offsets are packed back to back into 64-bit words, followed by one
+// spare word, so any field can be read with a fixed amount of loads.
+// * The size, bit width and base are kept in a header in front of the words,
+// in the same allocation, so a packedDataset is a single pointer.
+
+// Interface Invariant:
+// * Values are read back in O(1) through operator[], or all at once through
+// unpack().
+// * A packedDataset is immutable, it is built from the values it holds.
+
+// DESCRIPTION:
+// * packedDataset is a compact, random access form of a numMixer dataset. The
+// datasets multiMix seeds (values 2-100) take 7 bits per value instead of
+// the 32 of an int.
+
+// ASSUMPTIONS:
+// * Only datasets whose values span less than 2^32 can be packed (see
+// packable()), so every offset fits 32 bits.
+// * unpack() is built on the unpackBits() kernel (see mixKernels.h), which is
+// vectorized for int values.
+// * Equal values pack to equal words, so packedDatasets compare by their
+// words.
+// * A packedDataset is the size of a pointer, so holding one costs a numMixer
+// that does not pack its dataset a single word.
+// * basicPackedDataset<T> packs values of type T, and is instantiated for the
+// value types of the mixers (see packedDataset.cpp). packedDataset packs
+// ints.
+
+
+#ifndef packedDataset_INCLUDED
+#define packedDataset_INCLUDED
+
+
+#include <cstddef>  // size_t
+#include <cstdint>  // uint32_t, uint64_t
+#include <memory>  // unique_ptr
+#include <vector>  // vector
+
+
+#include "../include/mixKernels.h"
+
+
+template <typename T>
+class basicPackedDataset
+{
+	public:
+		// Constructors
+
+		basicPackedDataset();
+		// Description:
+		// * Creates an empty packedDataset. Allocates nothing.
+
+		explicit basicPackedDataset(const std::vector<T>& values);
+		// Description:
+		// * Packs "values", in the fewest bits that hold every offset from
+		// the smallest of them.
+		//
+		// Preconditions:
+		// * packable(values) must be true.
+
+		basicPackedDataset(const basicPackedDataset& obj);  // 1
+		basicPackedDataset(basicPackedDataset&& obj) = default;  // 2
+		basicPackedDataset& operator=(const basicPackedDataset& obj);  // 3
+		basicPackedDataset& operator=(basicPackedDataset&& obj) = default;  // 4
+		// Description (1-4):
+		// * Copies/moves the packed words.
+		// * A moved-from packedDataset is empty.
+
+
+		// Functionality
+
+		T operator[](unsigned int index) const;
+		// Description:
+		// * Returns the value at "index", in O(1).
+		//
+		// Preconditions:
+		// * "index" must be less than size().
+
+		void unpack(T* out) const;
+		// Description:
+		// * Stores every value, in order, into "out".
+		//
+		// Preconditions:
+		// * "out" must have room for size() values.
+
+		static bool packable(const std::vector<T>& values);
+		// Description:
+		// * Returns whether "values" can be packed: it is not empty, and its
+		// values span less than 2^32.
+
+
+		// Accessors
+
+		unsigned int size() const;
+		// Description:
+		// * Returns the amount of values.
+
+		bool empty() const;
+		// Description:
+		// * Returns whether there are no values.
+
+		T base() const;
+		// Description:
+		// * Returns the base, the smallest value.
+
+		unsigned int bitWidth() const;
+		// Description:
+		// * Returns the amount of bits each value is stored in.
+
+		std::size_t bytes() const;
+		// Description:
+		// * Returns the amount of heap memory the header and packed words
+		// take.
+
+		const std::uint64_t* words() const;
+		// Description:
+		// * Returns the packed words, for use with the kernels (see
+		// mixKernels.h).
+
+
+		// Comparison Operators
+
+		template <typename U>
+		friend bool operator==(const basicPackedDataset<U>& lhs,
+							   const basicPackedDataset<U>& rhs);  // 1
+		template <typename U>
+		friend bool operator!=(const basicPackedDataset<U>& lhs,
+							   const basicPackedDataset<U>& rhs);  // 2
+		// Description (1-2):
+		// * Compares the values held, through the packed words.
+
+
+	private:
+		// Utility
+
+		std::size_t wordCount() const;
+		// Description:
+		// * Returns the amount of words in the block, header included.
+
+
+		// Members
+
+		static const std::size_t _HEADER = 2;
+		// Header words: the size in the low and the bit width (0-32) in the
+		// high half of the first, the base in the second.
+
+		std::unique_ptr<std::uint64_t[]> _block;
+		// Header, then the packed offsets, then a spare word. Null if there
+		// are no values.
+};
+
+
+typedef basicPackedDataset<int> packedDataset;
+// Packed int dataset.
+
+
+template <typename T>
+inline T basicPackedDataset<T>::operator[](unsigned int index) const
+{
+	// unsigned arithmetic wraps instead of overflowing
+	return static_cast<T>(_block[1] +
+						  unpackField(words(), bitWidth(), index));
+}
+
+
+template <typename T>
+inline void basicPackedDataset<T>::unpack(T* out) const
+{
+	if (_block) {
+		unpackBits(words(), bitWidth(), base(), out, size());
+	}
+}
+
+
+template <typename T>
+inline unsigned int basicPackedDataset<T>::size() const
+{
+	return _block ? static_cast<std::uint32_t>(_block[0]) : 0;
+}
+
+
+template <typename T>
+inline bool basicPackedDataset<T>::empty() const
+{
+	return !_block;
+}
+
+
+template <typename T>
+inline T basicPackedDataset<T>::base() const
+{
+	return _block ? static_cast<T>(_block[1]) : T();
+}
+
+
+template <typename T>
+inline unsigned int basicPackedDataset<T>::bitWidth() const
+{
+	return _block ? static_cast<unsigned int>(_block[0] >> 32) : 0;
+}
+
+
+template <typename T>
+inline std::size_t basicPackedDataset<T>::bytes() const
+{
+	return wordCount() * sizeof(std::uint64_t);
+}
+
+
+template <typename T>
+inline const std::uint64_t* basicPackedDataset<T>::words() const
+{
+	return _block.get() + _HEADER;
+}
+
+
+template <typename T>
+inline std::size_t basicPackedDataset<T>::wordCount() const
+{
+	if (!_block) {
+		return 0;
+	}
+	const std::uint64_t BITS = static_cast<std::uint64_t>(size()) *
+							   bitWidth();
+	return _HEADER + (BITS + 63) / 64 + 1;
+}
+
+
+template <typename T>
+inline bool operator==(const basicPackedDataset<T>& lhs,
+					   const basicPackedDataset<T>& rhs)
+{
+	const std::size_t COUNT = lhs.wordCount();
+	if (COUNT != rhs.wordCount()) {
+		return false;
+	}
+	for (std::size_t i = 0; i < COUNT; ++i) {
+		if (lhs._block[i] != rhs._block[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+
+template <typename T>
+inline bool operator!=(const basicPackedDataset<T>& lhs,
+					   const basicPackedDataset<T>& rhs)
+{
+	return !operator==(lhs, rhs);
+}
+
+
+#endif
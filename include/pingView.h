@@ -0,0 +1,333 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: pingView.h
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Class Invariant:
+// * A pingView holds at most one block of values, the one being read. Values
+// past it have not been drawn yet.
+// * Once its producer reports the end, a pingView stays at the end.
+
+// Interface Invariant:
+// * pingViews are made by the mixers: numMixer::lazyPing(),
+// dubMix::lazyPing() and multiMix::lazyPings().
+// * Values are read through a range-for loop (begin(), end()), next(), or in
+// bulk through read(). All of them share one read position, so reading is
+// single pass: a view can not be rewound.
+
+// DESCRIPTION:
+// * pingView is a lazy, single-pass range over the output of a ping. Values
+// are drawn from the mixer in blocks, as they are read, so a consumer that
+// stops early only pays for the blocks it reached.
+
+// ASSUMPTIONS:
+// * A block is produced when a read finds the current one used up, never
+// before: making a view draws nothing, and begin() draws the first block.
+// * Countdown is consumed when a view first needs values from a numMixer, one
+// unit per numMixer ping the view stands for, however much of it is read. A
+// view that is never read consumes no countdown.
+// * The view points to its mixer, which must outlive it, and must not be
+// moved while it is read. Pings of the mixer between blocks are allowed, and
+// only advance its rng.
+// * Values are drawn from the dataset as it is when their block is produced.
+// * Producers are std::functions, holding the state of the ping in flight
+// (i.e. how many values are left), so a view can be moved, but not copied.
+// * Iterators point to the view, and are invalidated by moving it.
+// * basicPingView<T> reads values of type T (see numMixer.h). The value types
+// are instantiated at the bottom of pingView.cpp.
+
+
+#ifndef pingView_INCLUDED
+#define pingView_INCLUDED
+
+
+#include <cstddef>  // size_t, ptrdiff_t
+#include <cstdint>  // int16_t, int64_t
+#include <functional>  // function
+#include <iterator>  // input_iterator_tag
+#include <vector>  // vector
+
+
+template <typename T>
+class basicPingView
+{
+	public:
+		// Types
+
+		typedef T value_type;
+		// Type of the values read.
+
+		typedef std::function<bool(std::vector<T>& block)> Producer;
+		// Refills "block" with the next values of the ping, and returns
+		// whether there were any left. A block may come back empty without
+		// ending the ping, the view then asks for another.
+
+		class iterator
+		{
+			public:
+				typedef std::input_iterator_tag iterator_category;
+				typedef T value_type;
+				typedef std::ptrdiff_t difference_type;
+				typedef const T* pointer;
+				typedef const T& reference;
+
+				class proxy
+				{
+					public:
+						explicit proxy(const T& val);
+						const T& operator*() const;
+
+					private:
+						T _val;
+				};
+				// Result of a postfix increment, holding the value read
+				// before it, which the increment may have drawn a new
+				// block over.
+
+				iterator();  // 1
+				explicit iterator(basicPingView* pView);  // 2
+				// Description (1-2):
+				// * Create the end iterator (1), or one reading "pView" (2),
+				// which is the end iterator if "pView" is at its end.
+
+				const T& operator*() const;
+				// Description:
+				// * Returns the value at the read position.
+
+				iterator& operator++();  // 1
+				proxy operator++(int);  // 2
+				// Description (1-2):
+				// * Advance the read position, drawing a block if needed.
+				// * (2) returns a copy of the value it advanced past, so
+				// "*it++" reads it, as input iterators allow.
+
+				bool operator==(const iterator& rhs) const;  // 1
+				bool operator!=(const iterator& rhs) const;  // 2
+				// Description (1-2):
+				// * Iterators are equal if they read the same view, or are
+				// both at the end.
+
+			private:
+				basicPingView* _pView;
+				// View read, null at the end.
+		};
+		// Input iterator over a view.
+
+
+		// Constructors
+
+		basicPingView();
+		// Description:
+		// * Creates a view at its end, holding no values.
+
+		explicit basicPingView(Producer producer);
+		// Description:
+		// * Creates a view reading blocks from "producer". Nothing is drawn
+		// yet.
+
+		basicPingView(const basicPingView& obj) = delete;  // 1
+		basicPingView& operator=(const basicPingView& obj) = delete;  // 2
+		// Description (1-2):
+		// * A view holds the state of a ping in flight, and can not be
+		// copied.
+
+		basicPingView(basicPingView&& obj) = default;  // 3
+		basicPingView& operator=(basicPingView&& obj) = default;  // 4
+		// Description (3-4):
+		// * Moves the ping in flight.
+
+
+		// Functionality
+
+		iterator begin();  // 1
+		iterator end();  // 2
+		// Description (1-2):
+		// * Return an iterator at the read position (1), and the end iterator
+		// (2).
+
+		bool next(T& val);
+		// Description:
+		// * Stores the value at the read position into "val", and advances.
+		// * Returns false, leaving "val" untouched, at the end.
+
+		std::size_t read(T* out, std::size_t count);
+		// Description:
+		// * Stores up to "count" values from the read position into "out", and
+		// advances past them.
+		// * Returns the amount stored, less than "count" only at the end.
+
+		std::vector<T> collect();
+		// Description:
+		// * Returns every value left, drawing the whole rest of the ping.
+
+
+		// Accessors
+
+		bool done() const;
+		// Description:
+		// * Returns whether the view is known to be at its end. A view whose
+		// producer has not reported the end yet is not done, even if it has
+		// no values left.
+
+		static std::size_t blockSize();
+		// Description:
+		// * Returns the amount of values the mixers draw per block.
+
+
+	private:
+		// Utility
+
+		bool fill();
+		// Description:
+		// * Makes sure the read position holds a value, drawing blocks
+		// through refill() if the current one is used up.
+		// * Returns false at the end.
+
+		bool refill();
+		// Description:
+		// * Draws blocks until one holds values, or the producer ends, in
+		// which case the producer is dropped.
+		// * Returns false at the end.
+
+
+		// Members
+
+		static const std::size_t _BLOCK = 64;
+		// Values drawn per block.
+
+		Producer _producer;
+		// Draws blocks, null once the end is reached.
+
+		std::vector<T> _block;
+		// Block being read.
+
+		std::size_t _pos;
+		// Read position in "_block".
+};
+
+
+typedef basicPingView<int> pingView;
+typedef basicPingView<std::int16_t> pingView16;
+typedef basicPingView<std::int64_t> pingView64;
+// Views of int, 16-bit and 64-bit pings.
+
+
+template <typename T>
+inline basicPingView<T>::iterator::iterator():
+	_pView(0)
+{
+}
+
+
+template <typename T>
+inline basicPingView<T>::iterator::iterator(basicPingView* pView):
+	_pView(pView->fill() ? pView : 0)
+{
+}
+
+
+template <typename T>
+inline const T& basicPingView<T>::iterator::operator*() const
+{
+	return _pView->_block[_pView->_pos];
+}
+
+
+template <typename T>
+inline typename basicPingView<T>::iterator&
+basicPingView<T>::iterator::operator++()
+{
+	++_pView->_pos;
+	if (!_pView->fill()) {
+		_pView = 0;
+	}
+	return *this;
+}
+
+
+template <typename T>
+inline typename basicPingView<T>::iterator::proxy
+basicPingView<T>::iterator::operator++(int)
+{
+	proxy old(**this);
+	++*this;
+	return old;
+}
+
+
+template <typename T>
+inline basicPingView<T>::iterator::proxy::proxy(const T& val):
+	_val(val)
+{
+}
+
+
+template <typename T>
+inline const T& basicPingView<T>::iterator::proxy::operator*() const
+{
+	return _val;
+}
+
+
+template <typename T>
+inline bool basicPingView<T>::iterator::operator==(const iterator& rhs) const
+{
+	return _pView == rhs._pView;
+}
+
+
+template <typename T>
+inline bool basicPingView<T>::iterator::operator!=(const iterator& rhs) const
+{
+	return _pView != rhs._pView;
+}
+
+
+template <typename T>
+inline typename basicPingView<T>::iterator basicPingView<T>::begin()
+{
+	return iterator(this);
+}
+
+
+template <typename T>
+inline typename basicPingView<T>::iterator basicPingView<T>::end()
+{
+	return iterator();
+}
+
+
+template <typename T>
+inline bool basicPingView<T>::next(T& val)
+{
+	if (!fill()) {
+		return false;
+	}
+	val = _block[_pos++];
+	return true;
+}
+
+
+template <typename T>
+inline bool basicPingView<T>::done() const
+{
+	return !_producer && _pos == _block.size();
+}
+
+
+template <typename T>
+inline std::size_t basicPingView<T>::blockSize()
+{
+	return _BLOCK;
+}
+
+
+template <typename T>
+inline bool basicPingView<T>::fill()
+{
+	return _pos < _block.size() || (_producer && refill());
+}
+
+
+#endif
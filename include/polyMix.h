@@ -0,0 +1,185 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: polyMix.h
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Class Invariant:
+// * has-a relationship with numMixers, the "sources".
+// * Sources keep the controller state the client gave them.
+// * The mixing pattern is held as a compiled mixPlan.
+
+// Interface Invariant:
+// * The main functionality is provided in ping(). Output is mixed from the
+// sources as described by the plan.
+// * ping() returns an empty result unless the plan mixes exactly as many
+// sources as the polyMix contains.
+
+// DESCRIPTION:
+// * polyMix is the N-way generalization of dubMix. It mixes values from any
+// amount of numMixers, in a pattern described once by a mixPlan (weighted
+// round-robin, blocks, concatenate, optionally deduplicated).
+
+// ASSUMPTIONS:
+// * Each ping pulls the plan's amount of values from every source in one batch,
+// then gathers the output through the plan, without branching per value.
+// * A source whose ping fails contributes zeros, like an unanswered dubMix
+// ping.
+// * A polyMix over an EVEN and an ODD source with plan ROUND_ROBIN { 1, 1 }
+// returns what dubMix ctl 3 does, in the same order. With plan CONCATENATE
+// and dedup, it returns the same values as ctl 4, though not necessarily in
+// the same order, as duplicates are removed in a different order.
+// * Comparison (==) operators are supported.
+// * Comparison is performed on the plan and the sources.
+
+
+#ifndef polyMix_INCLUDED
+#define polyMix_INCLUDED
+
+
+#include <cstddef>  // size_t
+#include <functional>  // hash
+#include <vector>  // vector
+
+
+#include "../include/mixPlan.h"
+#include "../include/numMixer.h"
+
+
+class polyMix
+{
+	public:
+		// Constructors
+
+		polyMix();
+		// Description:
+		// * Creates a polyMix with no sources and an empty plan.
+
+		polyMix(std::vector<numMixer> sources, mixPlan plan);
+		// Description:
+		// * Creates a polyMix mixing "sources" as described by "plan".
+		// * "sources" and "plan" are moved into the polyMix.
+		// * If "plan" does not mix "sources.size()" sources, pings return
+		// empty results until a matching plan is set.
+
+
+		// Destructors
+
+		~polyMix();
+		// Description:
+		// * Placeholder, no-op
+
+
+		// Functionality
+
+		std::vector<int> ping();
+		// Description:
+		// * Pulls plan.pullCount(s) values from every source "s", then
+		// returns them in the order given by the plan.
+		// * Duplicates are removed if the plan says so.
+		// * Returns an empty result, pulling nothing, if the plan does not mix
+		// sourceCount() sources.
+
+
+		// Accessors
+
+		unsigned int sourceCount() const;
+		// Description:
+		// * Returns the amount of sources.
+
+		const numMixer& source(unsigned int index) const;
+		// Description:
+		// * Returns the source at "index".
+
+		const mixPlan& plan() const;
+		// Description:
+		// * Returns the plan.
+
+		std::size_t hash() const;
+		// Description:
+		// * Returns a fingerprint of the sources, in O(sources).
+		// * Equal polyMixes have equal fingerprints.
+
+
+		// Mutators
+
+		void addSource(numMixer source);
+		// Description:
+		// * Appends "source" to the sources.
+		// * The plan is not changed, and should be replaced to mix the new
+		// source.
+
+		void setPlan(mixPlan plan);
+		// Description:
+		// * Replaces the plan.
+
+
+		// Comparison Operators
+
+		friend bool operator==(const polyMix& lhs, const polyMix& rhs);  // 1
+		friend bool operator!=(const polyMix& lhs, const polyMix& rhs);  // 2
+		// Description (1-2):
+		// * Checks if the plans and the sources are the same.
+
+
+	private:
+		// Members
+
+		mixPlan _plan;
+		// The compiled mixing pattern.
+
+		std::vector<numMixer> _sources;
+		// The numMixers values are pulled from.
+
+		std::vector<int> _pulled;
+		// Pull buffer, reused between pings.
+};
+
+
+inline unsigned int polyMix::sourceCount() const
+{
+	return _sources.size();
+}
+
+
+inline const numMixer& polyMix::source(unsigned int index) const
+{
+	return _sources[index];
+}
+
+
+inline const mixPlan& polyMix::plan() const
+{
+	return _plan;
+}
+
+
+inline bool operator==(const polyMix& lhs, const polyMix& rhs)
+{
+	return (lhs._plan == rhs._plan &&
+			lhs._sources == rhs._sources);
+}
+
+
+inline bool operator!=(const polyMix& lhs, const polyMix& rhs)
+{
+	return !operator==(lhs, rhs);
+}
+
+
+namespace std
+{
+	template <>
+	struct hash<polyMix>
+	{
+		std::size_t operator()(const polyMix& obj) const
+		{
+			return obj.hash();
+		}
+	};
+}
+// Description:
+// * Lets polyMixes be used as keys in unordered containers.
+
+
+#endif
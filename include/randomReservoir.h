@@ -0,0 +1,278 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: randomReservoir.h
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Class Invariant:
+// * The reservoir holds two blocks of pre-generated rng output: the active
+// block, which draws are served from, and the spare block, which is refilled
+// ahead of time.
+// * The spare block is either ready (full, and owned by the consumer) or not
+// (owned by whoever refills it).
+
+// Interface Invariant:
+// * The reservoir satisfies UniformRandomBitGenerator, so it can drive any
+// standard distribution in place of an rng.
+// * When the active block runs out, the spare block takes its place if it is
+// ready (a hit). Otherwise (a miss) the spare block is taken if a refill in
+// progress finishes it, and the active block is refilled on the spot if not.
+// * refill() fills the spare block, i.e. during idle time.
+// * startBackgroundRefill() refills the spare block on a background thread,
+// whenever it has been taken.
+
+// DESCRIPTION:
+// * randomReservoir moves rng work out of latency-sensitive pings: the rng
+// runs in large blocks, ahead of time, and a draw is a single load from the
+// active block.
+
+// ASSUMPTIONS:
+// * Draws must come from one thread at a time. A reservoir can be owned by
+// one numMixer, or shared by the numMixers of one thread.
+// * The blocks are filled from the reservoir's own rng, seeded like the rngs
+// of the mixer classes.
+// * draws() and misses() are kept by the consuming thread, and should be read
+// from it. refills() and refillNanoseconds() may be read from any thread.
+
+
+#ifndef randomReservoir_INCLUDED
+#define randomReservoir_INCLUDED
+
+
+#include <atomic>  // atomic
+#include <condition_variable>  // condition_variable
+#include <cstddef>  // size_t
+#include <cstdint>  // uint32_t, uint64_t
+#include <mutex>  // mutex
+#include <random>  // mt19937
+#include <thread>  // thread
+#include <vector>  // vector
+
+
+class randomReservoir
+{
+	public:
+		// Types
+
+		typedef std::uint32_t result_type;
+		// Type of a draw, as required of a UniformRandomBitGenerator.
+
+
+		// Constructors
+
+		explicit randomReservoir(std::size_t blockSize = 4096);
+		// Description:
+		// * Creates a reservoir of two blocks of "blockSize" draws, both filled
+		// up front.
+		//
+		// Preconditions:
+		// * "blockSize" should be > 0.
+
+		randomReservoir(const randomReservoir& obj) = delete;  // 1
+		randomReservoir& operator=(const randomReservoir& obj) = delete;  // 2
+		// Description (1-2):
+		// * Reservoirs may own a thread, and can not be copied. Share them
+		// through a shared_ptr instead.
+
+
+		// Destructors
+
+		~randomReservoir();
+		// Description:
+		// * Stops the background refill, if it is running.
+
+
+		// Functionality
+
+		result_type operator()();
+		// Description:
+		// * Returns the next pre-generated draw.
+		// * Swaps in the spare block, or refills the active block, when the
+		// active block runs out.
+
+		static constexpr result_type min()
+		{
+			return std::mt19937::min();
+		}
+
+		static constexpr result_type max()
+		{
+			return std::mt19937::max();
+		}
+		// Description (min, max):
+		// * Range of a draw, as required of a UniformRandomBitGenerator.
+
+		void refill();
+		// Description:
+		// * Fills the spare block, if it is not ready.
+		// * Meant to be called during idle time, by the consuming thread or any
+		// other.
+
+		void startBackgroundRefill();
+		// Description:
+		// * Starts a thread that refills the spare block whenever it is taken.
+		// No-op if already started.
+
+		void stopBackgroundRefill();
+		// Description:
+		// * Stops and joins the background refill thread, if it is running.
+
+
+		// Accessors
+
+		std::size_t blockSize() const;
+		// Description:
+		// * Returns the amount of draws per block.
+
+		std::uint64_t draws() const;
+		// Description:
+		// * Returns the amount of draws served.
+
+		std::uint64_t misses() const;
+		// Description:
+		// * Returns the amount of times a draw found the active block empty and
+		// the spare block not ready, and had to wait for a refill in progress,
+		// or refill on the spot.
+
+		double hitRate() const;
+		// Description:
+		// * Returns the fraction of block changes served by a ready spare
+		// block, 1 if the active block never ran out.
+
+		std::uint64_t refills() const;
+		// Description:
+		// * Returns the amount of blocks filled, on the spot or ahead of time.
+
+		std::uint64_t refillNanoseconds() const;
+		// Description:
+		// * Returns the total time spent filling blocks, in nanoseconds.
+
+
+	private:
+		// Utility
+
+		void fill(std::vector<result_type>& block);
+		// Description:
+		// * Fills "block" from the rng, and adds the time it took to the
+		// counters.
+		//
+		// Preconditions:
+		// * "_engMutex" must be locked.
+
+		void backgroundRefill();
+		// Description:
+		// * Background thread loop, refills the spare block whenever it is not
+		// ready, until stopped.
+
+
+		// Members
+
+		std::vector<result_type> _active;
+		// Block draws are served from.
+
+		std::size_t _next;
+		// Index of the next draw in "_active".
+
+		std::vector<result_type> _spare;
+		// Block refilled ahead of time.
+
+		std::atomic<bool> _spareReady;
+		// Whether "_spare" is full, and owned by the consumer.
+
+		std::mt19937 _eng;
+		// Rng the blocks are filled from.
+
+		std::mutex _engMutex;
+		// Guards "_eng", and the wait for the spare block to be taken.
+
+		std::condition_variable _spareTaken;
+		// Signalled when the spare block is taken, or the refill thread is
+		// stopped.
+
+		bool _stopping;
+		// Tells the refill thread to exit, guarded by "_engMutex".
+
+		std::thread _refillThread;
+		// Background refill thread, if started.
+
+		std::uint64_t _blocks;
+		// Amount of block changes, from the consuming thread.
+
+		std::uint64_t _misses;
+		// Amount of block changes that refilled on the spot.
+
+		std::atomic<std::uint64_t> _refills;
+		// Amount of blocks filled.
+
+		std::atomic<std::uint64_t> _refillNanoseconds;
+		// Total time spent filling blocks.
+};
+
+
+inline randomReservoir::result_type randomReservoir::operator()()
+{
+	if (_next == _active.size()) {
+		++_blocks;
+		if (_spareReady.load(std::memory_order_acquire)) {
+			_active.swap(_spare);
+			_spareReady.store(false, std::memory_order_release);
+			{
+				// the refill thread may be between its check and its wait
+				std::lock_guard<std::mutex> lock(_engMutex);
+			}
+			_spareTaken.notify_one();
+		} else {
+			++_misses;
+			std::lock_guard<std::mutex> lock(_engMutex);
+			// a refill may have finished the spare while we waited
+			if (_spareReady.load(std::memory_order_acquire)) {
+				_active.swap(_spare);
+				_spareReady.store(false, std::memory_order_release);
+				_spareTaken.notify_one();
+			} else {
+				fill(_active);
+			}
+		}
+		_next = 0;
+	}
+	return _active[_next++];
+}
+
+
+inline std::size_t randomReservoir::blockSize() const
+{
+	return _active.size();
+}
+
+
+inline std::uint64_t randomReservoir::draws() const
+{
+	return (_blocks * _active.size()) + _next;
+}
+
+
+inline std::uint64_t randomReservoir::misses() const
+{
+	return _misses;
+}
+
+
+inline double randomReservoir::hitRate() const
+{
+	return _blocks ? 1.0 - double(_misses) / _blocks : 1.0;
+}
+
+
+inline std::uint64_t randomReservoir::refills() const
+{
+	return _refills.load();
+}
+
+
+inline std::uint64_t randomReservoir::refillNanoseconds() const
+{
+	return _refillNanoseconds.load();
+}
+
+
+#endif
@@ -0,0 +1,188 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: replenishPolicy.h
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Class Invariant:
+// * A replenishPolicy hands out pings to numMixers whose countdown has run
+// out.
+// * tokenBucket holds at most "capacity" tokens, and gains "rate" tokens per
+// second while below capacity.
+// * sharedBudget holds a fixed pool of pings, which only grows when the client
+// adds to it.
+
+// Interface Invariant:
+// * replenish() returns the amount of pings granted, 0 if none are available
+// right now. Granted pings are removed from the policy.
+// * All policies are thread-safe, so one policy can be shared by numMixers
+// living on different threads.
+
+// DESCRIPTION:
+// * replenishPolicy lets long-running numMixers refill their countdown instead
+// of going permanently inactive, so they can stay resident instead of being
+// rebuilt with a new dataset.
+
+// ASSUMPTIONS:
+// * numMixers hold their policy through a shared_ptr. Sharing one policy
+// between numMixers makes them draw from the same tokens/budget.
+// * tokenBucket starts full. Tokens accrue continuously, but are only granted
+// whole.
+// * Every replenish() grants at most "grant" pings, so one numMixer cannot
+// drain a shared policy in a single call.
+// * numMixers call replenish() only when pinged with no countdown left, so
+// pings are only granted to numMixers in use.
+
+
+#ifndef replenishPolicy_INCLUDED
+#define replenishPolicy_INCLUDED
+
+
+#include <atomic>  // atomic
+#include <chrono>  // steady_clock
+#include <mutex>  // mutex
+
+
+class replenishPolicy
+{
+	public:
+		// Destructors
+
+		virtual ~replenishPolicy();
+		// Description:
+		// * Placeholder, no-op
+
+
+		// Functionality
+
+		virtual int replenish() = 0;
+		// Description:
+		// * Takes pings from the policy for an exhausted numMixer.
+		// * Returns the amount of pings granted, 0 if none are available.
+};
+
+
+class tokenBucket : public replenishPolicy
+{
+	public:
+		// Constructors
+
+		tokenBucket(int capacity, double rate, int grant);
+		// Description:
+		// * Creates a full bucket of "capacity" tokens, refilling at "rate"
+		// tokens per second, granting at most "grant" tokens per call.
+		//
+		// Preconditions:
+		// * "capacity", "rate" and "grant" should be > 0.
+
+
+		// Functionality
+
+		int replenish() override;
+		// Description:
+		// * Refills the bucket for the time passed since the last call, then
+		// grants up to "grant" whole tokens.
+
+
+		// Accessors
+
+		double tokens();
+		// Description:
+		// * Returns the amount of tokens in the bucket, refilled up to now.
+
+
+	private:
+		// Utility
+
+		void refill();
+		// Description:
+		// * Adds the tokens accrued since "_lastRefill", up to "_capacity".
+		//
+		// Preconditions:
+		// * "_mutex" must be locked.
+
+
+		// Members
+
+		const double _capacity;
+		// Most tokens the bucket holds.
+
+		const double _rate;
+		// Tokens gained per second.
+
+		const int _grant;
+		// Most tokens granted per call.
+
+		double _tokens;
+		// Tokens in the bucket as of "_lastRefill".
+
+		std::chrono::steady_clock::time_point _lastRefill;
+		// Time "_tokens" was last brought up to date.
+
+		std::mutex _mutex;
+		// Guards "_tokens" and "_lastRefill".
+};
+
+
+class sharedBudget : public replenishPolicy
+{
+	public:
+		// Constructors
+
+		sharedBudget(long long budget, int grant);
+		// Description:
+		// * Creates a budget of "budget" pings, granting at most "grant" pings
+		// per call.
+		//
+		// Preconditions:
+		// * "budget" should be >= 0, "grant" should be > 0.
+
+
+		// Functionality
+
+		int replenish() override;
+		// Description:
+		// * Grants up to "grant" pings from the budget, lock-free.
+
+
+		// Accessors
+
+		long long remaining() const;
+		// Description:
+		// * Returns the amount of pings left in the budget.
+
+
+		// Mutators
+
+		void add(long long pings);
+		// Description:
+		// * Adds "pings" to the budget.
+		//
+		// Preconditions:
+		// * "pings" should be > 0.
+
+
+	private:
+		// Members
+
+		const int _grant;
+		// Most pings granted per call.
+
+		std::atomic<long long> _remaining;
+		// Pings left in the budget.
+};
+
+
+inline long long sharedBudget::remaining() const
+{
+	return _remaining.load();
+}
+
+
+inline void sharedBudget::add(long long pings)
+{
+	_remaining += pings;
+}
+
+
+#endif
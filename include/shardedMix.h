@@ -0,0 +1,268 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: shardedMix.h
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Class Invariant:
+// * A shardedMix splits its numMixers across a fixed amount of shards, set on
+// construction. Each shard is a multiMix of its own, with its own lock and
+// statistics.
+// * Every shard runs the same schedule policy, which is never STACK (see the
+// constructors).
+// * A shard is flagged drained once none of its numMixers is scheduled, and
+// unflagged when numMixers are added to it.
+
+// Interface Invariant:
+// * The main functionality is provided in ping(), which is safe to call from
+// any amount of threads at once.
+// * ping() is served by the calling thread's home shard, or, once that shard
+// is drained, stolen from the next shard that is not.
+// * An empty result is returned once every shard is drained.
+
+// DESCRIPTION:
+// * shardedMix is a multiMix for many threads. A single multiMix funnels all
+// traffic through one stack and one lock, a shardedMix gives each thread a
+// shard of its own, so threads only contend once they start stealing.
+
+// ASSUMPTIONS:
+// * Threads are handed home shards round-robin, in the order they first ping
+// any shardedMix. With at least as many shards as pinging threads, every
+// thread has a shard to itself.
+// * numMixers draw from the rngs of the pinging thread (see mixSeed.h), so
+// shards never share rng state.
+// * Shards are allocated separately and padded, so no two shards share a
+// cache line.
+// * A shardedMix owns locks, and can be moved but not copied.
+// * A shardedMix made from a mixTopology has a shard per cpu of the topology.
+// Each shard's numMixers are seeded on a thread pinned to its cpu, so their
+// datasets are placed on its node, and threads that call pinThread() run on
+// the cpu of their home shard, so their pings stay node-local.
+
+
+#ifndef shardedMix_INCLUDED
+#define shardedMix_INCLUDED
+
+
+#include <atomic>  // atomic
+#include <cstddef>  // size_t
+#include <cstdint>  // uint64_t
+#include <memory>  // unique_ptr
+#include <mutex>  // mutex
+#include <vector>  // vector
+
+
+#include "../include/mixResult.h"
+#include "../include/mixTopology.h"
+#include "../include/multiMix.h"
+
+
+class shardedMix
+{
+	public:
+		// Types
+
+		struct shardStats
+		{
+			std::uint64_t pings;
+			std::uint64_t steals;
+			int numMixers;
+			int scheduled;
+		};
+		// Statistics of a shard: pings served, how many of those were stolen
+		// by threads homed elsewhere, numMixers held and numMixers scheduled.
+
+
+		// Constructors
+
+		explicit shardedMix(
+				unsigned int shardCount = 0,
+				multiMix::SchedulePolicy policy = multiMix::COUNTDOWN);
+		// Description:
+		// * Creates "shardCount" empty shards, scheduled by "policy". A
+		// "shardCount" of 0 creates one shard per hardware thread.
+		// * A "policy" of STACK is replaced by COUNTDOWN.
+
+		explicit shardedMix(
+				const mixTopology& topology,
+				multiMix::SchedulePolicy policy = multiMix::COUNTDOWN);
+		// Description:
+		// * Creates an empty shard for every cpu of "topology", placed on the
+		// cpu's node, scheduled by "policy".
+		// * A "policy" of STACK is replaced by COUNTDOWN.
+
+		shardedMix(const shardedMix& obj) = delete;  // 1
+		shardedMix& operator=(const shardedMix& obj) = delete;  // 2
+		shardedMix(shardedMix&& obj) = default;  // 3
+		shardedMix& operator=(shardedMix&& obj) = default;  // 4
+		// Description (1-4):
+		// * A shardedMix can not be copied. Moving transfers the shards.
+		// * A shardedMix must not be moved while it is being pinged.
+
+
+		// Functionality
+
+		mixResult ping();
+		// Description:
+		// * Same as multiMix::ping(), on the home shard of the calling thread.
+		// * Once the home shard is drained, the other shards are tried in
+		// order, starting after it, and the first that is not drained serves
+		// the ping. A shard whose numMixers all wait on their replenishPolicy
+		// stays undrained, but is passed over like a drained one.
+		// * Returns an empty result once every shard is drained, or passed
+		// over.
+
+		bool pinThread() const;
+		// Description:
+		// * Pins the calling thread to the cpu of its home shard.
+		// * Returns whether the thread was pinned. Always false unless the
+		// shardedMix was made from a mixTopology.
+
+
+		// Accessors
+
+		unsigned int shardCount() const;
+		// Description:
+		// * Returns the amount of shards.
+
+		unsigned int homeShard() const;
+		// Description:
+		// * Returns the index of the calling thread's home shard.
+
+		bool isPlaced() const;
+		// Description:
+		// * Returns whether the shards are placed on the nodes of a topology.
+
+		unsigned int shardNode(unsigned int shard) const;
+		// Description:
+		// * Returns the node shard "shard" is placed on, 0 if the shards are
+		// not placed.
+
+		multiMix::SchedulePolicy schedulePolicy() const;
+		// Description:
+		// * Returns the schedule policy of the shards.
+
+		shardStats getShardStats(unsigned int shard) const;
+		// Description:
+		// * Returns the statistics of shard "shard".
+		//
+		// Preconditions:
+		// * "shard" must be < shardCount().
+
+		shardStats getStats() const;
+		// Description:
+		// * Returns the statistics of every shard, summed.
+
+		int getNumMixerCount() const;
+		// Description:
+		// * Returns the amount of numMixers across the shards.
+
+		int getScheduledCount() const;
+		// Description:
+		// * Returns the amount of numMixers ping() may still pick, across the
+		// shards.
+
+
+		// Mutators
+
+		void addNumMixers(unsigned int count);
+		// Description:
+		// * Seeds "count" numMixers, spread evenly across the shards, and
+		// schedules them.
+		// * If the shards are placed, each shard's share is seeded on a thread
+		// pinned to its cpu.
+		//
+		// Preconditions:
+		// * "count" should be greater than 0.
+
+		void addNumMixersParallel(unsigned int count);
+		// Description:
+		// * Same as addNumMixers(count), but each shard seeds its share on a
+		// thread of its own, so its numMixers are first touched by that
+		// thread, and the shards are seeded concurrently.
+
+
+	private:
+		// Types
+
+		struct shard
+		{
+			mutable std::mutex lock;
+			multiMix mix;
+			std::uint64_t pings;
+			std::uint64_t steals;
+			std::atomic<bool> drained;
+			char pad[64];
+		};
+		// A shard, guarded by "lock". "drained" may be read without it.
+		// "pad" keeps the next allocation off the shard's last cache line.
+
+
+		// Utility
+
+		static unsigned int threadIndex();
+		// Description:
+		// * Returns the index of the calling thread, handed out in the order
+		// threads first ask for one.
+
+		unsigned int share(unsigned int shard, unsigned int count) const;
+		// Description:
+		// * Returns how many of "count" numMixers go to shard "shard".
+
+		void seedShard(unsigned int shard, unsigned int count);
+		// Description:
+		// * Seeds "count" numMixers on shard "shard", on the calling thread,
+		// pinning it to the shard's cpu first if the shards are placed.
+
+		void createShards(unsigned int shardCount);
+		// Description:
+		// * Creates "shardCount" empty shards.
+
+
+		// Members
+
+		std::vector<std::unique_ptr<shard> > _shards;
+		// Shards, allocated separately.
+
+		multiMix::SchedulePolicy _schedulePolicy;
+		// Schedule policy of every shard.
+
+		mixTopology _topology;
+		// Topology shard i is placed on, at cpu number i.
+
+		bool _placed;
+		// Whether the shards are placed on "_topology".
+};
+
+
+inline unsigned int shardedMix::shardCount() const
+{
+	return _shards.size();
+}
+
+
+inline unsigned int shardedMix::homeShard() const
+{
+	return threadIndex() % _shards.size();
+}
+
+
+inline bool shardedMix::isPlaced() const
+{
+	return _placed;
+}
+
+
+inline unsigned int shardedMix::shardNode(unsigned int shard) const
+{
+	return _placed ? _topology.nodeOfCpu(shard) : 0;
+}
+
+
+inline multiMix::SchedulePolicy shardedMix::schedulePolicy() const
+{
+	return _schedulePolicy;
+}
+
+
+#endif
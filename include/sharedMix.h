@@ -0,0 +1,363 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: sharedMix.h
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Class Invariant:
+// * An attached sharedMix maps a whole segment: a header, a record per
+// numMixer (dataset location, parity counts, countdown), then every dataset,
+// back to back.
+// * A segment is only attached once its creator has written all of it, and is
+// never resized afterwards.
+// * Only countdowns and the active count change after creation, and only
+// through atomic operations.
+
+// Interface Invariant:
+// * One process creates a segment from a multiMix through create(), any
+// process on the host may then attach to it by name through attach().
+// * ping() pings the topmost numMixer that still has countdown left, as
+// multiMix does under policy STACK, and is safe to call from any amount of
+// threads and processes at once.
+// * A sharedMix that failed to create or attach is detached, see
+// isAttached().
+
+// DESCRIPTION:
+// * sharedMix is a read-mostly multiMix living in POSIX shared memory. Worker
+// processes on the same host share one copy of the numMixers and their
+// datasets, instead of each building and holding its own.
+
+// ASSUMPTIONS:
+// * Segments are POSIX shared memory objects (shm_open), named as shm_open
+// expects, i.e. "/mixPool". On other platforms create() and attach() fail.
+// * Segments are created with owner-only permissions, so only processes of
+// the same user can attach.
+// * The segment outlives every sharedMix mapping it, until remove() is
+// called. create() fails if the name is taken, so a stale segment left by a
+// crashed process must be removed first.
+// * The segment holds offsets, not pointers, so it may be mapped at a
+// different address in every process.
+// * Countdowns are lock-free atomics, which work across processes. A ping
+// claims one unit of countdown with a compare-and-swap, so a countdown is
+// never overdrawn, however many processes ping.
+// * Once the topmost numMixer runs out, the first ping to notice retires it by
+// lowering the shared active count, so every process moves on to the next.
+// * States follow the stack index, as in multiMix: "Mix", "Even", "Odd",
+// repeating every third index, with primes removed from "Mix" pings.
+// * Pings draw from an rng of the calling thread, seeded with the process id
+// (see mixSeed.h), and reseeded in the child after a fork, so processes never
+// share rng state, even when forked from a process that already pinged.
+// * Replenish policies and reservoirs are process-local objects, and are not
+// carried into the segment. A shared numMixer is exhausted once its
+// countdown, as copied from the source, runs out.
+// * A sharedMix owns a mapping, and can be moved but not copied.
+// * basicSharedMix<T> shares numMixers of values of type T (see numMixer.h).
+// Processes can only attach to segments of their own value type. The value
+// types are instantiated at the bottom of sharedMix.cpp.
+
+
+#ifndef sharedMix_INCLUDED
+#define sharedMix_INCLUDED
+
+
+#include <atomic>  // atomic
+#include <cstddef>  // size_t
+#include <cstdint>  // int16_t, int32_t, int64_t, uint32_t, uint64_t
+#include <string>  // string
+#include <vector>  // vector
+
+
+#include "../include/mixResult.h"
+#include "../include/multiMix.h"
+#include "../include/numMixer.h"
+
+
+template <typename T>
+class basicSharedMix
+{
+	public:
+		// Types
+
+		typedef T value_type;
+		typedef basicNumMixer<T> numMixer;
+		typedef basicMultiMix<T> multiMix;
+		typedef basicMixResult<T> mixResult;
+		// Values, numMixers, multiMixes and results of the sharedMix's value
+		// type.
+
+
+		// Constructors
+
+		basicSharedMix();
+		// Description:
+		// * Creates a detached sharedMix. Maps nothing.
+
+		static basicSharedMix create(const std::string& name,
+									 const multiMix& source);
+		// Description:
+		// * Creates the segment "name", copies the numMixer stack of "source"
+		// into it, with their datasets and countdowns, and returns a
+		// sharedMix attached to it.
+		// * Returns a detached sharedMix if the segment could not be created,
+		// i.e. if "name" is taken.
+
+		static basicSharedMix attach(const std::string& name);
+		// Description:
+		// * Maps the existing segment "name" and returns a sharedMix attached
+		// to it. Nothing is copied.
+		// * Returns a detached sharedMix if there is no such segment, if its
+		// creator has not finished writing it, or if it holds values of
+		// another type.
+
+		basicSharedMix(const basicSharedMix& obj) = delete;  // 1
+		basicSharedMix& operator=(const basicSharedMix& obj) = delete;  // 2
+		// Description (1-2):
+		// * A sharedMix owns a mapping, and can not be copied. Attach again to
+		// map the segment twice.
+
+		basicSharedMix(basicSharedMix&& obj);  // 3
+		basicSharedMix& operator=(basicSharedMix&& obj);  // 4
+		// Description (3-4):
+		// * Moves the mapping. "obj" is left detached.
+
+
+		// Destructors
+
+		~basicSharedMix();
+		// Description:
+		// * Unmaps the segment. The segment itself is left in place, see
+		// remove().
+
+
+		// Functionality
+
+		mixResult ping();
+		// Description:
+		// * Pings the topmost numMixer with countdown left, and returns a
+		// result depending on its state, as multiMix::ping() does.
+		// * numMixers found exhausted are retired for every process.
+		// * An empty result is returned once every numMixer is retired.
+		//
+		// Preconditions:
+		// * The sharedMix must be attached.
+
+		mixResult ping(std::size_t index);
+		// Description:
+		// * Same as ping(), but pings the numMixer at "index", retired or not.
+		// * Returns an empty result if it is exhausted, or holds no values of
+		// its state's parity.
+		//
+		// Preconditions:
+		// * The sharedMix must be attached, and "index" must be less than
+		// getNumMixerCount().
+
+		static bool remove(const std::string& name);
+		// Description:
+		// * Removes the segment "name". Processes attached to it keep their
+		// mapping until they detach, but no process can attach any more.
+		// * Returns whether there was such a segment.
+
+
+		// Accessors
+
+		bool isAttached() const;
+		// Description:
+		// * Returns whether the sharedMix maps a segment.
+
+		const std::string& name() const;
+		// Description:
+		// * Returns the name of the segment, empty if detached.
+
+		std::size_t bytes() const;
+		// Description:
+		// * Returns the size of the segment, 0 if detached.
+
+		int getNumMixerCount() const;
+		// Description:
+		// * Returns the amount of numMixers in the segment.
+
+		int getActiveCount() const;
+		// Description:
+		// * Returns the amount of numMixers not yet retired, i.e. the index of
+		// the topmost one plus 1.
+
+		int countDown(std::size_t index) const;
+		// Description:
+		// * Returns the countdown left to the numMixer at "index".
+		//
+		// Preconditions:
+		// * The sharedMix must be attached, and "index" must be less than
+		// getNumMixerCount().
+
+		std::vector<T> dataset(std::size_t index) const;
+		// Description:
+		// * Returns a copy of the dataset of the numMixer at "index".
+		//
+		// Preconditions:
+		// * The sharedMix must be attached, and "index" must be less than
+		// getNumMixerCount().
+
+
+		// Mutators
+
+		static void seed(std::uint32_t seed);
+		// Description:
+		// * Reseeds the rng of the calling thread with "seed", so the pings
+		// that follow on this thread are reproducible.
+
+
+	private:
+		// Types
+
+		struct segmentHeader
+		{
+			std::atomic<std::uint32_t> ready;
+			std::atomic<std::uint32_t> activeCount;
+			std::uint32_t valueSize;
+			std::uint32_t mixerCount;
+			std::uint64_t magic;
+			std::uint64_t bytes;
+			std::uint64_t valuesOffset;
+		};
+		// Start of a segment. "ready" is set last, once the rest of the
+		// segment is written.
+
+		struct mixerRecord
+		{
+			std::uint64_t datasetOffset;
+			std::uint32_t datasetSize;
+			std::uint32_t evenCount;
+			std::uint32_t oddCount;
+			std::atomic<std::int32_t> countDown;
+		};
+		// A shared numMixer: where its dataset starts among the values, its
+		// size and parity counts, and its countdown.
+
+
+		// Constructors
+
+		basicSharedMix(const std::string& name, void* segment,
+					   std::size_t bytes);
+		// Description:
+		// * Attaches to the segment "name", mapped at "segment".
+
+
+		// Utility
+
+		bool pingSlot(std::size_t index, mixResult& returnset);
+		// Description:
+		// * Claims a unit of countdown from the numMixer at "index" and pings
+		// it into "returnset".
+		// * Returns false, leaving "returnset" untouched, if it is exhausted
+		// or holds no values of its state's parity.
+		//
+		// Preconditions:
+		// * "returnset" should be size > 0.
+
+		void detach();
+		// Description:
+		// * Unmaps the segment, if any, and leaves the sharedMix detached.
+
+		segmentHeader* header() const;
+		// Description:
+		// * Returns the header of the segment.
+
+		mixerRecord* records() const;
+		// Description:
+		// * Returns the numMixer records, following the header.
+
+		const T* values() const;
+		// Description:
+		// * Returns the dataset values, following the records.
+
+
+		// Members
+
+		static const std::uint64_t _MAGIC = 0x685378694d6d756eULL;
+		// Marks a segment written by a sharedMix ("numMixSh" in memory).
+
+		std::string _name;
+		// Name of the segment.
+
+		void* _segment;
+		// Start of the mapping, null if detached.
+
+		std::size_t _bytes;
+		// Size of the mapping.
+};
+
+
+typedef basicSharedMix<int> sharedMix;
+typedef basicSharedMix<std::int16_t> sharedMix16;
+typedef basicSharedMix<std::int64_t> sharedMix64;
+// sharedMixes of int, 16-bit and 64-bit values.
+
+
+template <typename T>
+inline bool basicSharedMix<T>::isAttached() const
+{
+	return _segment;
+}
+
+
+template <typename T>
+inline const std::string& basicSharedMix<T>::name() const
+{
+	return _name;
+}
+
+
+template <typename T>
+inline std::size_t basicSharedMix<T>::bytes() const
+{
+	return _bytes;
+}
+
+
+template <typename T>
+inline int basicSharedMix<T>::getNumMixerCount() const
+{
+	return _segment ? header()->mixerCount : 0;
+}
+
+
+template <typename T>
+inline int basicSharedMix<T>::getActiveCount() const
+{
+	return _segment ?
+		   header()->activeCount.load(std::memory_order_relaxed) : 0;
+}
+
+
+template <typename T>
+inline int basicSharedMix<T>::countDown(std::size_t index) const
+{
+	return records()[index].countDown.load(std::memory_order_relaxed);
+}
+
+
+template <typename T>
+inline typename basicSharedMix<T>::segmentHeader*
+basicSharedMix<T>::header() const
+{
+	return static_cast<segmentHeader*>(_segment);
+}
+
+
+template <typename T>
+inline typename basicSharedMix<T>::mixerRecord*
+basicSharedMix<T>::records() const
+{
+	return reinterpret_cast<mixerRecord*>(header() + 1);
+}
+
+
+template <typename T>
+inline const T* basicSharedMix<T>::values() const
+{
+	return reinterpret_cast<const T*>(static_cast<const char*>(_segment) +
+									  header()->valuesOffset);
+}
+
+
+#endif
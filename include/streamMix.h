@@ -0,0 +1,296 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: streamMix.h
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Class Invariant:
+// * A streamMix holds at most "capacity" values, set on construction, however
+// many values are ingested.
+// * Once "capacity" values have been ingested, the values held are a uniform
+// random sample of every value ingested so far.
+// * The values held are partitioned by parity: even values from the front of
+// the buffer, odd values from the back, and the even/odd counts are always
+// up to date with them.
+
+// Interface Invariant:
+// * Values are fed in through ingest(), one at a time or as a range.
+// * ping() returns random values of the requested parity from the sample, and
+// fails while the sample holds no values of that parity.
+// * snapshot() returns a numMixer of the current sample, to feed into the
+// other mixer classes.
+
+// DESCRIPTION:
+// * streamMix builds the dataset of a numMixer from an unbounded stream,
+// keeping a fixed size, uniformly representative reservoir sample of it
+// instead of the whole stream.
+
+// ASSUMPTIONS:
+// * Sampling follows Algorithm L: once the reservoir is full, the amount of
+// values to skip before the next replacement is drawn up front, so skipped
+// values cost a decrement, and only kept values draw from the rng.
+// * Values must be ingested by one thread at a time. Pings may come from any
+// amount of threads, concurrently with ingestion.
+// * The sample is guarded by a lock, taken by pings, and by ingestion only
+// when a value is kept. Skipped values never take it.
+// * Pings draw from the rng of the calling thread (see mixSeed.h), ingestion
+// from an rng of the streamMix's own.
+// * Pings of a parity draw straight from its partition, so they never retry.
+// * A streamMix has no countdown: it stays active for as long as it holds
+// values of the requested parity.
+// * basicStreamMix<T> samples values of type T (see numMixer.h). The value
+// types are instantiated at the bottom of streamMix.cpp.
+
+
+#ifndef streamMix_INCLUDED
+#define streamMix_INCLUDED
+
+
+#include <atomic>  // atomic
+#include <cstdint>  // int16_t, int64_t, uint64_t
+#include <mutex>  // mutex
+#include <random>  // mt19937
+#include <vector>  // vector
+
+
+#include "../include/mixValue.h"
+#include "../include/numMixer.h"
+
+
+template <typename T>
+class basicStreamMix
+{
+	public:
+		// Types
+
+		typedef T value_type;
+		typedef basicNumMixer<T> numMixer;
+		typedef typename numMixer::OutputController OutputController;
+		// Values, numMixers and parities of the streamMix's value type.
+
+
+		// Constructors
+
+		explicit basicStreamMix(unsigned int capacity);
+		// Description:
+		// * Creates an empty streamMix sampling up to "capacity" values.
+		// * The buffer is allocated once, here.
+		//
+		// Preconditions:
+		// * "capacity" must be > 0.
+
+		basicStreamMix(const basicStreamMix& obj) = delete;  // 1
+		basicStreamMix& operator=(const basicStreamMix& obj) = delete;  // 2
+		// Description (1-2):
+		// * A streamMix owns a lock, and can not be copied. Use snapshot() to
+		// copy its sample.
+
+
+		// Functionality
+
+		void ingest(T val);
+		// Description:
+		// * Offers "val" to the sample.
+		// * Until the reservoir is full every value is kept. After that, "val"
+		// is kept with probability capacity() / seen(), replacing a random
+		// value of the sample.
+
+		template <typename InputIt>
+		void ingest(InputIt first, InputIt last);
+		// Description:
+		// * Same as ingest(val) for every value of [first, last).
+
+		bool ping(std::vector<T>& returnValues,
+				  OutputController parity = numMixer::MIX);
+		// Description:
+		// * Stores a random selection of values of parity "parity" from the
+		// sample into "returnValues", as many as its size.
+		// * Returns false, leaving "returnValues" untouched, if the sample
+		// holds no values of parity "parity".
+
+		bool ping(T* returnValues, unsigned int size,
+				  OutputController parity = numMixer::MIX);
+		// Description:
+		// * Same as ping(returnValues, parity), but stores "size" values
+		// straight into the caller's buffer "returnValues".
+		//
+		// Preconditions:
+		// * "returnValues" must have room for "size" values.
+
+		numMixer snapshot() const;
+		// Description:
+		// * Returns a numMixer whose dataset is the current sample.
+		//
+		// Preconditions:
+		// * The sample must hold at least one value.
+
+
+		// Accessors
+
+		unsigned int capacity() const;
+		// Description:
+		// * Returns the most values the sample can hold.
+
+		unsigned int size() const;
+		// Description:
+		// * Returns the amount of values in the sample.
+
+		std::uint64_t seen() const;
+		// Description:
+		// * Returns the amount of values ingested so far.
+
+		std::uint64_t kept() const;
+		// Description:
+		// * Returns the amount of ingested values that entered the sample.
+
+		unsigned int evenCount() const;  // 1
+		unsigned int oddCount() const;  // 2
+		// Description (1-2):
+		// * Return the amount of even (1) and odd (2) values in the sample.
+
+		bool evenValid() const;  // 1
+		bool oddValid() const;  // 2
+		// Description (1-2):
+		// * Return whether pings for even (1) and odd (2) values are valid.
+
+
+	private:
+		// Utility
+
+		void keep(T val);
+		// Description:
+		// * Adds "val" to the sample, replacing a random value if it is full,
+		// and draws how many values to skip before the next one is kept.
+
+		void insertValue(T val);
+		// Description:
+		// * Adds "val" to the end of its parity partition.
+		//
+		// Preconditions:
+		// * "_lock" must be locked, and the sample must not be full.
+
+		void removeSlot(unsigned int slot);
+		// Description:
+		// * Removes sample value number "slot", evens numbered before odds.
+		//
+		// Preconditions:
+		// * "_lock" must be locked, and "slot" must be < size().
+
+		void drawSkip();
+		// Description:
+		// * Advances "_w", and draws "_skip" from it.
+
+		double drawUnit();
+		// Description:
+		// * Returns a uniform draw from (0, 1], from "_ingestEng". Draws of 0
+		// are redrawn.
+
+
+		// Members
+
+		static thread_local std::mt19937 _eng;
+		// Rng of the pinging thread. One per thread and value type.
+
+		std::vector<T> _buffer;
+		// Sample, even values from the front, odd values from the back.
+
+		unsigned int _evenCount;
+		// Amount of even values, at the front of "_buffer".
+
+		unsigned int _oddCount;
+		// Amount of odd values, at the back of "_buffer".
+
+		mutable std::mutex _lock;
+		// Guards "_buffer", "_evenCount" and "_oddCount".
+
+		std::mt19937 _ingestEng;
+		// Rng of the ingesting thread.
+
+		double _w;
+		// Algorithm L's running W, the largest of the sample's random keys.
+
+		std::uint64_t _skip;
+		// Amount of values left to skip before the next one is kept.
+
+		std::atomic<std::uint64_t> _seen;
+		// Amount of values ingested.
+
+		std::atomic<std::uint64_t> _kept;
+		// Amount of values kept.
+};
+
+
+typedef basicStreamMix<int> streamMix;
+typedef basicStreamMix<std::int16_t> streamMix16;
+typedef basicStreamMix<std::int64_t> streamMix64;
+// streamMixes of int, 16-bit and 64-bit values.
+
+
+template <typename T>
+inline void basicStreamMix<T>::ingest(T val)
+{
+	// only the ingesting thread writes "_seen", so no atomic add is needed
+	_seen.store(_seen.load(std::memory_order_relaxed) + 1,
+				std::memory_order_relaxed);
+	if (_skip) {
+		--_skip;
+	} else {
+		keep(val);
+	}
+}
+
+
+template <typename T>
+template <typename InputIt>
+void basicStreamMix<T>::ingest(InputIt first, InputIt last)
+{
+	std::uint64_t seen = 0;
+	for (; first != last; ++first) {
+		++seen;
+		if (_skip) {
+			--_skip;
+		} else {
+			keep(*first);
+		}
+	}
+	_seen.store(_seen.load(std::memory_order_relaxed) + seen,
+				std::memory_order_relaxed);
+}
+
+
+template <typename T>
+inline unsigned int basicStreamMix<T>::capacity() const
+{
+	return _buffer.size();
+}
+
+
+template <typename T>
+inline std::uint64_t basicStreamMix<T>::seen() const
+{
+	return _seen.load(std::memory_order_relaxed);
+}
+
+
+template <typename T>
+inline std::uint64_t basicStreamMix<T>::kept() const
+{
+	return _kept.load(std::memory_order_relaxed);
+}
+
+
+template <typename T>
+inline bool basicStreamMix<T>::evenValid() const
+{
+	return (evenCount() > 0);
+}
+
+
+template <typename T>
+inline bool basicStreamMix<T>::oddValid() const
+{
+	return (oddCount() > 0);
+}
+
+
+#endif
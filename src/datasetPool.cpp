@@ -0,0 +1,106 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: datasetPool.cpp
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Implementation Invariant:
+// * Pooled buffers are kept in a vector used as a free list, whose capacity is
+// reserved up front so releasing a buffer never reallocates the list.
+// * Buffers are cleared on release, but keep their allocation.
+
+
+#include <cstdint>  // int16_t, int64_t
+#include <vector>  // vector
+#include <utility>  // move
+
+
+#include "../include/datasetPool.h"
+
+
+template <typename T>
+basicDatasetPool<T>::basicDatasetPool(unsigned int capacity):
+	_capacity(capacity),
+	_hits(0),
+	_misses(0),
+	_buffers()
+{
+	_buffers.reserve(_capacity);
+}
+
+
+template <typename T>
+basicDatasetPool<T>::basicDatasetPool(const basicDatasetPool& obj):
+	_capacity(obj._capacity),
+	_hits(0),
+	_misses(0),
+	_buffers()
+{
+	_buffers.reserve(_capacity);
+}
+
+
+template <typename T>
+basicDatasetPool<T>& basicDatasetPool<T>::operator=(
+		const basicDatasetPool& obj)
+{
+	if (this != &obj) {
+		_capacity = obj._capacity;
+		_buffers.clear();
+		_buffers.reserve(_capacity);
+	}
+	return *this;
+}
+
+
+template <typename T>
+basicDatasetPool<T>::~basicDatasetPool()
+{
+}
+
+
+template <typename T>
+std::vector<T> basicDatasetPool<T>::acquire(unsigned int size)
+{
+	if (_buffers.empty()) {
+		++_misses;
+		return std::vector<T>(size);
+	}
+
+	++_hits;
+	std::vector<T> buffer(std::move(_buffers.back()));
+	_buffers.pop_back();
+	buffer.resize(size);
+	return buffer;
+}
+
+
+template <typename T>
+void basicDatasetPool<T>::release(std::vector<T>&& buffer)
+{
+	if (_buffers.size() < _capacity) {
+		buffer.clear();
+		_buffers.push_back(std::move(buffer));
+	} else {
+		std::vector<T>().swap(buffer);
+	}
+}
+
+
+template <typename T>
+void basicDatasetPool<T>::reserve(unsigned int count, unsigned int size)
+{
+	if (_capacity < count) {
+		_capacity = count;
+		_buffers.reserve(_capacity);
+	}
+	while (_buffers.size() < count) {
+		_buffers.push_back(std::vector<T>());
+		_buffers.back().reserve(size);
+	}
+}
+
+
+template class basicDatasetPool<std::int16_t>;
+template class basicDatasetPool<int>;
+template class basicDatasetPool<std::int64_t>;
\ No newline at end of file
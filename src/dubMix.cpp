@@ -9,19 +9,42 @@
 // * "_z" is set to odd.
 // * ping returns values depending on "_ctl".
 // * Client decides when to set "_ctl".
-// * In case of "_ctl" == 4, even/odd vectors are purged of duplicates, then
-// merged.
-
-
+// * In case of "_ctl" == 4, even/odd values are pinged into the two halves of
+// the output, then purged of duplicates and compacted in one pipeline pass.
+// * Pings are run through "_pipeline" once assembled, before any sort. An
+// empty pipeline returns without reading the values.
+// * numMixers are pinged straight into output/scratch buffers, and merged by
+// the mixKernels, so no per-index branching is done.
+// * In sorted output mode, results are sorted in place once assembled. ctl 3
+// and 4 skip the merge kernels, as sorting puts the values in their final
+// order regardless, and ctl 4 leaves duplicates to the sort.
+// * Lazy views of ctl 1-3 read blocks from numMixer views, merging and
+// running each through a copy of the pipeline. Views that need the whole ping
+// call ping(size) at their first block, and hand out its result.
+// * Output and scratch buffers are mixResults, which hold ordinary pings
+// (size <= 10) inline, so they do not allocate.
+
+
+#include <algorithm>  // min
+#include <cstdint>  // int16_t, int64_t
+#include <memory>  // make_shared, shared_ptr
+#include <utility>  // move
 #include <vector>  // vector
 
 
 #include "../include/dubMix.h"
+#include "../include/mixKernels.h"
+#include "../include/mixPipeline.h"
+#include "../include/mixResult.h"
 #include "../include/numMixer.h"
+#include "../include/pingView.h"
 
 
-dubMix::dubMix():
+template <typename T>
+basicDubMix<T>::basicDubMix():
 	_ctl(3),
+	_sortedOutput(false),
+	_pipeline(),
 	_x(),
 	_z()
 {
@@ -30,105 +53,186 @@ dubMix::dubMix():
 }
 
 
-dubMix::~dubMix()
+template <typename T>
+basicDubMix<T>::~basicDubMix()
 {
 }
 
 
-std::vector<int> dubMix::ping()
+template <typename T>
+typename basicDubMix<T>::mixResult basicDubMix<T>::ping()
 {
 	const unsigned int SIZE = 10;
+	return ping(SIZE);
+}
+
+
+template <typename T>
+typename basicDubMix<T>::mixResult basicDubMix<T>::ping(unsigned int size)
+{
 	switch (_ctl) {
 		case 1:
-			return ctl1(SIZE);
+			return ctl1(size);
 		case 2:
-			return ctl2(SIZE);
+			return ctl2(size);
 		case 3:
-			return ctl3(SIZE);
+			return ctl3(size);
 		case 4:
-			return ctl4(SIZE);
+			return ctl4(size);
 		default:
-			return std::vector<int> (0);
+			return mixResult();
 	}
 }
 
 
-void dubMix::setCtl(unsigned int val)
+template <typename T>
+typename basicDubMix<T>::pingView basicDubMix<T>::lazyPing(unsigned int size)
+{
+	if (_ctl < 1 || _ctl > 4) {
+		return pingView();
+	}
+
+	if (_ctl == 4 || _sortedOutput || _pipeline.dedup()) {
+		bool pinged = false;
+		return pingView([this, size, pinged](std::vector<T>& block) mutable {
+			if (pinged) {
+				return false;
+			}
+			pinged = true;
+			const mixResult OUT = ping(size);
+			block.assign(OUT.begin(), OUT.end());
+			return true;
+		});
+	}
+
+	// views are move-only, so the producers share them
+	const mixPipeline PIPELINE = _pipeline;
+	if (_ctl != 3) {
+		std::shared_ptr<pingView> pSource = std::make_shared<pingView>(
+			(_ctl == 1 ? _x : _z).lazyPing(size));
+		return pingView([pSource, PIPELINE](std::vector<T>& block) {
+			block.resize(pingView::blockSize());
+			const std::size_t COUNT = pSource->read(block.data(),
+													block.size());
+			block.resize(PIPELINE.apply(block.data(), COUNT));
+			return COUNT > 0;
+		});
+	}
+
+	std::shared_ptr<pingView> pX = std::make_shared<pingView>(
+		_x.lazyPing(size));
+	std::shared_ptr<pingView> pZ = std::make_shared<pingView>(
+		_z.lazyPing(size));
+	std::vector<T> scratch(pingView::blockSize());
+	return pingView([pX, pZ, PIPELINE, scratch](
+		std::vector<T>& block) mutable {
+		const std::size_t HALF = scratch.size() / 2;
+		T* xOut = scratch.data();
+		T* zOut = scratch.data() + HALF;
+		const std::size_t COUNT = std::min(pX->read(xOut, HALF),
+										   pZ->read(zOut, HALF));
+		block.resize(2 * COUNT);
+		interleave(xOut, zOut, block.data(), COUNT);
+		block.resize(PIPELINE.apply(block.data(), block.size()));
+		return COUNT > 0;
+	});
+}
+
+
+template <typename T>
+void basicDubMix<T>::setCtl(unsigned int val)
 {
 	_ctl = val;
 }
 
 
-void dubMix::purgeDuplicates(std::vector<int>& arr)
+template <typename T>
+void basicDubMix<T>::setSortedOutput(bool sorted)
 {
-	int newSize = arr.size();
-	for (int i = arr.size() - 1; i >= 1; --i) {
-		for (int j = i - 1; j >= 0; --j) {
-			if (arr[j] == arr[i]) {
-				arr[i] = arr[newSize - 1];
-				--newSize;
-				break;
-			}
-		}
-	}
-	arr.resize(newSize);
+	_sortedOutput = sorted;
 }
 
 
-std::vector<int> dubMix::ctl1(unsigned int size)
+template <typename T>
+void basicDubMix<T>::setPipeline(mixPipeline pipeline)
 {
-	std::vector<int> xOut(size);
-	_x.ping(xOut);
+	_pipeline = std::move(pipeline);
+}
+
+
+template <typename T>
+typename basicDubMix<T>::mixResult basicDubMix<T>::ctl1(unsigned int size)
+{
+	mixResult xOut(size);
+	_x.ping(xOut.data(), size);
+	_pipeline.apply(xOut);
+	if (_sortedOutput) {
+		sortValues(xOut.data(), xOut.size());
+	}
 	return xOut;
 }
 
 
-std::vector<int> dubMix::ctl2(unsigned int size)
+template <typename T>
+typename basicDubMix<T>::mixResult basicDubMix<T>::ctl2(unsigned int size)
 {
-	std::vector<int> zOut(size);
-	_z.ping(zOut);
+	mixResult zOut(size);
+	_z.ping(zOut.data(), size);
+	_pipeline.apply(zOut);
+	if (_sortedOutput) {
+		sortValues(zOut.data(), zOut.size());
+	}
 	return zOut;
 }
 
 
-std::vector<int> dubMix::ctl3(unsigned int size)
+template <typename T>
+typename basicDubMix<T>::mixResult basicDubMix<T>::ctl3(unsigned int size)
 {
-	std::vector<int> xOut(size);
-	_x.ping(xOut);
-
-	std::vector<int> zOut(size);
-	_z.ping(zOut);
-
-	std::vector<int> mixedOut(2 * size);
-	for (int i = 0; i < 2 * size; ++i) {
-		if (i % 2 == 0) {
-			mixedOut[i] = xOut[i / 2];
-		} else {
-			mixedOut[i] = zOut[i / 2];
-		}
+	if (_sortedOutput) {
+		mixResult sortedOut(2 * size);
+		_x.ping(sortedOut.data(), size);
+		_z.ping(sortedOut.data() + size, size);
+		_pipeline.apply(sortedOut);
+		sortValues(sortedOut.data(), sortedOut.size());
+		return sortedOut;
 	}
 
+	mixResult scratch(2 * size);
+	T* xOut = scratch.data();
+	T* zOut = scratch.data() + size;
+	_x.ping(xOut, size);
+	_z.ping(zOut, size);
+
+	mixResult mixedOut(2 * size);
+	interleave(xOut, zOut, mixedOut.data(), size);
+	_pipeline.apply(mixedOut);
+
 	return mixedOut;
 }
 
 
-std::vector<int> dubMix::ctl4(unsigned int size)
+template <typename T>
+typename basicDubMix<T>::mixResult basicDubMix<T>::ctl4(unsigned int size)
 {
-	std::vector<int> xOut(size);
-	_x.ping(xOut);
-	purgeDuplicates(xOut);
-
-	std::vector<int> zOut(size);
-	_z.ping(zOut);
-	purgeDuplicates(zOut);
-
-	std::vector<int> mixedOut(xOut.size() + zOut.size());
-	for (int i = 0; i < xOut.size(); ++i) {
-		mixedOut[i] = xOut[i];
-	}
-	for (int i = 0; i < zOut.size(); ++i) {
-		mixedOut[i + xOut.size()] = zOut[i];
+	mixResult mixedOut(2 * size);
+	T* xOut = mixedOut.data();
+	T* zOut = mixedOut.data() + size;
+
+	_x.ping(xOut, size);
+	_z.ping(zOut, size);
+	if (_sortedOutput) {
+		_pipeline.apply(mixedOut);
+		mixedOut.resize(sortUniqueValues(mixedOut.data(), mixedOut.size()));
+		return mixedOut;
 	}
 
+	_pipeline.apply(mixedOut, true);
+
 	return mixedOut;
-}
\ No newline at end of file
+}
+
+
+template class basicDubMix<std::int16_t>;
+template class basicDubMix<int>;
+template class basicDubMix<std::int64_t>;
\ No newline at end of file
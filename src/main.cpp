@@ -24,12 +24,12 @@
 
 #include <cmath>  // floor, ceil
 #include <ctime>  // time
-#include <stack>  // stack
 #include <vector>  // vector
 #include <fstream>  // ofstream
 #include <ostream>  // endl
 #include <random>  // mt19937, uniform_int_distribution
 #include <string>  // string, to_string
+#include <utility>  // move
 
 
 #include "../include/dubMix.h"
@@ -41,7 +41,9 @@ template <typename T>
 struct Mixer
 {
 	Mixer() {}
-	Mixer(T objT, std::string nameT): obj(objT), name(nameT) {}
+	Mixer(T objT, std::string nameT):
+		obj(std::move(objT)),
+		name(std::move(nameT)) {}
 	T obj;
 	std::string name;
 };
@@ -49,9 +51,10 @@ struct Mixer
 // * Abstracts the various mixer classes so they can be templated.
 // * "obj" is the mixer object.
 // * "name" is the name of the object.
+// * "objT" and "nameT" are moved into place, so temporaries are not copied.
 
 
-void writeHeader(std::vector<std::string> vec, std::ofstream& ofs);
+void writeHeader(const std::vector<std::string>& vec, std::ofstream& ofs);
 
 int genRandNum();
 
@@ -68,19 +71,23 @@ void testRel(Mixer<T>& lhs, Mixer<T>& rhs, std::ofstream& ofs);
 template <typename T>
 void testMixers(Mixer<T>& mixer1,
 				Mixer<T>& mixer2,
-				std::string className,
+				const std::string& className,
 				std::ofstream& ofs);
 
 void testMultiMixersMixArith(std::ofstream& ofs);
 
 void printStats(const numMixer& nm,
-				std::string nmName,
+				const std::string& nmName,
 				std::ofstream& ofs,
 				bool verbose = true);
 
-void printStats(const dubMix& dm, std::string dmName, std::ofstream& ofs);
+void printStats(const dubMix& dm,
+				const std::string& dmName,
+				std::ofstream& ofs);
 
-void printStats(const multiMix& mm, std::string mmName, std::ofstream& ofs);
+void printStats(const multiMix& mm,
+				const std::string& mmName,
+				std::ofstream& ofs);
 
 
 inline const std::string toString(const bool b)
@@ -127,7 +134,7 @@ int main()
 // * Closes the log file.
 
 
-void writeHeader(std::vector<std::string> vec, std::ofstream& ofs)
+void writeHeader(const std::vector<std::string>& vec, std::ofstream& ofs)
 {
 	const int WIDTH = 26;
 	std::string border(WIDTH, '#');
@@ -141,7 +148,7 @@ void writeHeader(std::vector<std::string> vec, std::ofstream& ofs)
 	double dynWidth;
 	int widthLeft;
 	int widthRight;
-	for (auto header : vec) {
+	for (const auto& header : vec) {
 		dynWidth = WIDTH - header.length();
 		widthLeft = std::floor(dynWidth / 2);
 		widthRight = std::ceil(dynWidth / 2);
@@ -241,7 +248,7 @@ void testRel(Mixer<T>& lhs, Mixer<T>& rhs, std::ofstream& ofs)
 template <typename T>
 void testMixers(Mixer<T>& mixer1,
 				Mixer<T>& mixer2,
-				std::string className,
+				const std::string& className,
 				std::ofstream& ofs)
 {
 	writeHeader({className, "Overloaded Operators"}, ofs);
@@ -285,7 +292,7 @@ void testMultiMixersMixArith(std::ofstream& ofs)
 	printStats(nm1, "nm1", ofs, false);
 	ofs << std::endl;
 
-	mm1 += nm1;
+	mm1 += std::move(nm1);
 	printStats(mm1, "mm1 += nm1", ofs);
 }
 // Description:
@@ -295,7 +302,7 @@ void testMultiMixersMixArith(std::ofstream& ofs)
 
 
 void printStats(const numMixer& nm,
-				std::string nmName,
+				const std::string& nmName,
 				std::ofstream& ofs,
 				bool verbose)
 {
@@ -315,7 +322,9 @@ void printStats(const numMixer& nm,
 // object.
 
 
-void printStats(const dubMix& dm, std::string dmName, std::ofstream& ofs)
+void printStats(const dubMix& dm,
+				const std::string& dmName,
+				std::ofstream& ofs)
 {
 	const int SIZE = 28;
 	std::string border(SIZE, '=');
@@ -332,20 +341,21 @@ void printStats(const dubMix& dm, std::string dmName, std::ofstream& ofs)
 // * Prints the states of the member variables within the given dubMixer object.
 
 
-void printStats(const multiMix& mm, std::string mmName, std::ofstream& ofs)
+void printStats(const multiMix& mm,
+				const std::string& mmName,
+				std::ofstream& ofs)
 {
 	const int SIZE = 28;
 	std::string border(SIZE, '=');
 	ofs << border << std::endl;
 	ofs << "== \"" << mmName << "\" STATS ==\n";
 	ofs << "Stack size: " << mm.getNumMixerCount() << std::endl;
-	std::stack<numMixer> stackCopy = mm.numMixerStack();
+	const std::vector<numMixer>& stack = mm.numMixerStack();
 	std::string index;
-	while (!stackCopy.empty()) {
+	for (int i = stack.size() - 1; i >= 0; --i) {
 		ofs << std::endl;
-		index = "index [" + std::to_string(stackCopy.size() - 1) + "]";
-		printStats(stackCopy.top(), index, ofs, false);
-		stackCopy.pop();
+		index = "index [" + std::to_string(i) + "]";
+		printStats(stack[i], index, ofs, false);
 	}
 	ofs << border << std::endl;
 }
@@ -0,0 +1,172 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: mixAsync.cpp
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Implementation Invariant:
+// * pingThen()/pingAllThen() are the core of the API. Futures and awaitables
+// are built on top of their callbacks.
+// * Awaitables are instantiated at the bottom, when built with coroutine
+// support, so a C++20 build compiles every member of them.
+// * pingAllThen() never waits on the executor: the chunk that finishes last,
+// as counted by "pending", delivers the results.
+
+
+#include <algorithm>  // min
+#include <atomic>  // atomic
+#include <cstddef>  // size_t
+#include <future>  // future, promise
+#include <memory>  // shared_ptr, make_shared
+#include <utility>  // move
+#include <vector>  // vector
+
+
+#include "../include/dubMix.h"
+#include "../include/mixAsync.h"
+#include "../include/mixExecutor.h"
+#include "../include/multiMix.h"
+#include "../include/numMixer.h"
+
+
+struct pingAllState
+{
+	std::vector<std::vector<int> > results;
+	std::atomic<unsigned int> pending;
+	pingAllCallback done;
+};
+// Description:
+// * Shared by the chunks of a pingAllThen() call.
+
+
+template <typename Result>
+static std::function<void(Result)> fulfil(
+		std::shared_ptr<std::promise<Result> > promise)
+{
+	return [promise](Result result) {
+		promise->set_value(std::move(result));
+	};
+}
+// Description:
+// * Returns a callback that fulfils "promise".
+
+
+void pingThen(numMixer& obj,
+			  unsigned int size,
+			  pingCallback done,
+			  mixExecutor& executor)
+{
+	executor.post([&obj, size, done]() {
+		std::vector<int> returnValues(size);
+		if (!obj.ping(returnValues)) {
+			returnValues.clear();
+		}
+		done(std::move(returnValues));
+	});
+}
+
+
+void pingThen(dubMix& obj,
+			  unsigned int size,
+			  pingCallback done,
+			  mixExecutor& executor)
+{
+	executor.post([&obj, size, done]() {
+		done(obj.ping(size).toVector());
+	});
+}
+
+
+void pingThen(multiMix& obj, pingCallback done, mixExecutor& executor)
+{
+	executor.post([&obj, done]() {
+		done(obj.ping().toVector());
+	});
+}
+
+
+void pingAllThen(std::vector<numMixer>& mixers,
+				 unsigned int size,
+				 pingAllCallback done,
+				 mixExecutor& executor)
+{
+	const std::size_t COUNT = mixers.size();
+	const std::size_t CHUNKS = std::min<std::size_t>(executor.threadCount(),
+													 COUNT);
+	if (CHUNKS == 0) {
+		executor.post([done]() { done(std::vector<std::vector<int> >()); });
+		return;
+	}
+
+	auto state = std::make_shared<pingAllState>();
+	state->results.resize(COUNT);
+	state->pending = CHUNKS;
+	state->done = std::move(done);
+	for (std::size_t chunk = 0; chunk < CHUNKS; ++chunk) {
+		const std::size_t FIRST = COUNT * chunk / CHUNKS;
+		const std::size_t LAST = COUNT * (chunk + 1) / CHUNKS;
+		executor.post([&mixers, size, state, FIRST, LAST]() {
+			for (std::size_t i = FIRST; i < LAST; ++i) {
+				std::vector<int>& returnValues = state->results[i];
+				returnValues.resize(size);
+				if (!mixers[i].ping(returnValues)) {
+					returnValues.clear();
+				}
+			}
+			if (--state->pending == 0) {
+				state->done(std::move(state->results));
+			}
+		});
+	}
+}
+
+
+std::future<std::vector<int> > pingAsync(numMixer& obj,
+										 unsigned int size,
+										 mixExecutor& executor)
+{
+	auto promise = std::make_shared<std::promise<std::vector<int> > >();
+	std::future<std::vector<int> > result = promise->get_future();
+	pingThen(obj, size, fulfil(promise), executor);
+	return result;
+}
+
+
+std::future<std::vector<int> > pingAsync(dubMix& obj,
+										 unsigned int size,
+										 mixExecutor& executor)
+{
+	auto promise = std::make_shared<std::promise<std::vector<int> > >();
+	std::future<std::vector<int> > result = promise->get_future();
+	pingThen(obj, size, fulfil(promise), executor);
+	return result;
+}
+
+
+std::future<std::vector<int> > pingAsync(multiMix& obj,
+										 mixExecutor& executor)
+{
+	auto promise = std::make_shared<std::promise<std::vector<int> > >();
+	std::future<std::vector<int> > result = promise->get_future();
+	pingThen(obj, fulfil(promise), executor);
+	return result;
+}
+
+
+std::future<std::vector<std::vector<int> > > pingAllAsync(
+		std::vector<numMixer>& mixers,
+		unsigned int size,
+		mixExecutor& executor)
+{
+	typedef std::vector<std::vector<int> > Results;
+	auto promise = std::make_shared<std::promise<Results> >();
+	std::future<Results> result = promise->get_future();
+	pingAllThen(mixers, size, fulfil(promise), executor);
+	return result;
+}
+
+
+#ifdef MIX_ASYNC_COROUTINES
+template class mixAwaitable<std::vector<int> >;
+template class mixAwaitable<std::vector<std::vector<int> > >;
+#endif
\ No newline at end of file
@@ -0,0 +1,86 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: mixExecutor.cpp
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Implementation Invariant:
+// * Workers sleep on "_wake" while "_tasks" is empty, and run tasks outside of
+// "_mutex".
+// * The default executor is a function-local static, so it is created
+// thread-safely on first use, and joined at exit.
+
+
+#include <algorithm>  // max
+#include <functional>  // function
+#include <mutex>  // mutex, lock_guard, unique_lock
+#include <thread>  // thread, hardware_concurrency
+#include <utility>  // move
+
+
+#include "../include/mixExecutor.h"
+
+
+mixExecutor::mixExecutor(unsigned int threadCount):
+	_mutex(),
+	_wake(),
+	_tasks(),
+	_stopping(false),
+	_workers()
+{
+	if (threadCount == 0) {
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+	}
+	_workers.reserve(threadCount);
+	for (unsigned int i = 0; i < threadCount; ++i) {
+		_workers.emplace_back(&mixExecutor::work, this);
+	}
+}
+
+
+mixExecutor::~mixExecutor()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stopping = true;
+	}
+	_wake.notify_all();
+	for (auto& worker : _workers) {
+		worker.join();
+	}
+}
+
+
+void mixExecutor::post(std::function<void()> task)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_tasks.push_back(std::move(task));
+	}
+	_wake.notify_one();
+}
+
+
+void mixExecutor::work()
+{
+	for (;;) {
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_wake.wait(lock, [this]() { return _stopping || !_tasks.empty(); });
+			if (_tasks.empty()) {
+				return;
+			}
+			task = std::move(_tasks.front());
+			_tasks.pop_front();
+		}
+		task();
+	}
+}
+
+
+mixExecutor& defaultMixExecutor()
+{
+	static mixExecutor executor;
+	return executor;
+}
\ No newline at end of file
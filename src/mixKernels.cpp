@@ -0,0 +1,525 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: mixKernels.cpp
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Implementation Invariant:
+// * SIMD variants are compiled with per-function target attributes, so the
+// rest of the project does not need to be built with -mavx2.
+// * The variant is chosen on the first call to interleave() and cached in a
+// function-local static, whose initialization is thread-safe.
+// * SIMD variants handle whole vectors and leave the tail to the scalar
+// variant.
+// * SIMD variants are templates over the value type. The unpack instruction
+// for the value width is picked by overload, on the type of the source
+// pointer.
+// * The AVX2 unpackBits() variant reads the fields as little-endian bytes,
+// which x86 is. 8 fields of w bits span exactly w bytes, so every group of 8
+// fields sits at the same byte offsets and shifts from its first byte.
+// * Sorting works on the 64-bit unsigned image of each value, in which the
+// span of any value type fits. The radix sort flips the sign bit of signed
+// values, so their bytes order like unsigned ones.
+// * Sort scratch (counts, radix buffer) is thread_local, and grows to the
+// largest sort of the thread, so steady-state sorts do not allocate.
+
+
+#include <algorithm>  // minmax_element, sort, unique, copy, swap
+#include <cstddef>  // size_t
+#include <cstdint>  // int16_t, int64_t, uint32_t, uint64_t
+#include <type_traits>  // is_signed
+#include <vector>  // vector
+
+
+#include "../include/mixKernels.h"
+
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MIX_KERNELS_X86
+#include <immintrin.h>  // AVX2, SSE2 intrinsics
+#endif
+
+
+template <typename T>
+struct interleaveKernel
+{
+	void (*fn)(const T*, const T*, T*, std::size_t);
+	const char* name;
+};
+// Description:
+// * An interleave() variant for values of type T, and its name.
+
+
+template <typename T>
+struct unpackBitsKernel
+{
+	void (*fn)(const std::uint64_t*, unsigned int, T, T*, std::size_t);
+	const char* name;
+};
+// Description:
+// * An unpackBits() variant for values of type T, and its name.
+
+
+template <typename T>
+void interleaveScalar(const T* even,
+					  const T* odd,
+					  T* out,
+					  std::size_t count)
+{
+	for (std::size_t i = 0; i < count; ++i) {
+		out[2 * i] = even[i];
+		out[2 * i + 1] = odd[i];
+	}
+}
+
+
+template <typename T>
+void unpackBitsScalar(const std::uint64_t* words,
+					  unsigned int width,
+					  T base,
+					  T* out,
+					  std::size_t count)
+{
+	// unsigned arithmetic wraps instead of overflowing
+	const std::uint64_t BASE = static_cast<std::uint64_t>(base);
+	for (std::size_t i = 0; i < count; ++i) {
+		out[i] = static_cast<T>(BASE + unpackField(words, width, i));
+	}
+}
+
+
+#ifdef MIX_KERNELS_X86
+
+
+__attribute__((target("sse2")))
+static inline __m128i unpackLo(__m128i e, __m128i o, const std::int16_t*)
+{
+	return _mm_unpacklo_epi16(e, o);
+}
+
+
+__attribute__((target("sse2")))
+static inline __m128i unpackLo(__m128i e, __m128i o, const int*)
+{
+	return _mm_unpacklo_epi32(e, o);
+}
+
+
+__attribute__((target("sse2")))
+static inline __m128i unpackLo(__m128i e, __m128i o, const std::int64_t*)
+{
+	return _mm_unpacklo_epi64(e, o);
+}
+
+
+__attribute__((target("sse2")))
+static inline __m128i unpackHi(__m128i e, __m128i o, const std::int16_t*)
+{
+	return _mm_unpackhi_epi16(e, o);
+}
+
+
+__attribute__((target("sse2")))
+static inline __m128i unpackHi(__m128i e, __m128i o, const int*)
+{
+	return _mm_unpackhi_epi32(e, o);
+}
+
+
+__attribute__((target("sse2")))
+static inline __m128i unpackHi(__m128i e, __m128i o, const std::int64_t*)
+{
+	return _mm_unpackhi_epi64(e, o);
+}
+// Description:
+// * Interleave the low/high halves of "e" and "o", value by value. The last
+// parameter only picks the value width.
+
+
+__attribute__((target("avx2")))
+static inline __m256i unpackLo(__m256i e, __m256i o, const std::int16_t*)
+{
+	return _mm256_unpacklo_epi16(e, o);
+}
+
+
+__attribute__((target("avx2")))
+static inline __m256i unpackLo(__m256i e, __m256i o, const int*)
+{
+	return _mm256_unpacklo_epi32(e, o);
+}
+
+
+__attribute__((target("avx2")))
+static inline __m256i unpackLo(__m256i e, __m256i o, const std::int64_t*)
+{
+	return _mm256_unpacklo_epi64(e, o);
+}
+
+
+__attribute__((target("avx2")))
+static inline __m256i unpackHi(__m256i e, __m256i o, const std::int16_t*)
+{
+	return _mm256_unpackhi_epi16(e, o);
+}
+
+
+__attribute__((target("avx2")))
+static inline __m256i unpackHi(__m256i e, __m256i o, const int*)
+{
+	return _mm256_unpackhi_epi32(e, o);
+}
+
+
+__attribute__((target("avx2")))
+static inline __m256i unpackHi(__m256i e, __m256i o, const std::int64_t*)
+{
+	return _mm256_unpackhi_epi64(e, o);
+}
+// Description:
+// * Same as above, within each 128-bit lane of "e" and "o".
+
+
+template <typename T>
+__attribute__((target("sse2")))
+static void interleaveSse2(const T* even,
+						   const T* odd,
+						   T* out,
+						   std::size_t count)
+{
+	const std::size_t WIDTH = sizeof(__m128i) / sizeof(T);
+	std::size_t i = 0;
+	for (; i + WIDTH <= count; i += WIDTH) {
+		__m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(even + i));
+		__m128i o = _mm_loadu_si128(reinterpret_cast<const __m128i*>(odd + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i),
+						 unpackLo(e, o, even));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + WIDTH),
+						 unpackHi(e, o, even));
+	}
+	interleaveScalar(even + i, odd + i, out + 2 * i, count - i);
+}
+// Description:
+// * Interleaves a 128-bit vector of values from each source per iteration.
+
+
+template <typename T>
+__attribute__((target("avx2")))
+static void interleaveAvx2(const T* even,
+						   const T* odd,
+						   T* out,
+						   std::size_t count)
+{
+	const std::size_t WIDTH = sizeof(__m256i) / sizeof(T);
+	std::size_t i = 0;
+	for (; i + WIDTH <= count; i += WIDTH) {
+		__m256i e = _mm256_loadu_si256(
+				reinterpret_cast<const __m256i*>(even + i));
+		__m256i o = _mm256_loadu_si256(
+				reinterpret_cast<const __m256i*>(odd + i));
+		// unpack works within 128-bit lanes (32-bit values shown):
+		// lo = e0 o0 e1 o1 | e4 o4 e5 o5
+		// hi = e2 o2 e3 o3 | e6 o6 e7 o7
+		__m256i lo = unpackLo(e, o, even);
+		__m256i hi = unpackHi(e, o, even);
+		// so the lanes are reassembled in order
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i),
+							_mm256_permute2x128_si256(lo, hi, 0x20));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i + WIDTH),
+							_mm256_permute2x128_si256(lo, hi, 0x31));
+	}
+	interleaveScalar(even + i, odd + i, out + 2 * i, count - i);
+}
+// Description:
+// * Interleaves a 256-bit vector of values from each source per iteration.
+
+
+__attribute__((target("avx2")))
+static void unpackBitsAvx2(const std::uint64_t* words,
+						   unsigned int width,
+						   int base,
+						   int* out,
+						   std::size_t count)
+{
+	const unsigned int MAX_WIDTH = 25;
+	const std::size_t WIDTH = sizeof(__m256i) / sizeof(int);
+	std::size_t i = 0;
+	if (width <= MAX_WIDTH) {
+		// a field of up to 25 bits fits the 4 bytes from its first byte
+		const char* bytes = reinterpret_cast<const char*>(words);
+		const __m256i BIT = _mm256_mullo_epi32(
+				_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+				_mm256_set1_epi32(width));
+		const __m256i OFFSET = _mm256_srli_epi32(BIT, 3);
+		const __m256i SHIFT = _mm256_and_si256(BIT, _mm256_set1_epi32(7));
+		const __m256i MASK = _mm256_set1_epi32((1u << width) - 1);
+		const __m256i BASE = _mm256_set1_epi32(base);
+		for (; i + WIDTH <= count; i += WIDTH) {
+			const int* group = reinterpret_cast<const int*>(
+					bytes + i / WIDTH * width);
+			__m256i v = _mm256_i32gather_epi32(group, OFFSET, 1);
+			v = _mm256_and_si256(_mm256_srlv_epi32(v, SHIFT), MASK);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+								_mm256_add_epi32(v, BASE));
+		}
+	}
+	const std::uint64_t TAIL_BASE = static_cast<std::uint64_t>(base);
+	for (; i < count; ++i) {
+		out[i] = static_cast<int>(TAIL_BASE + unpackField(words, width, i));
+	}
+}
+// Description:
+// * Unpacks 8 int fields per iteration, by gathering the 4 bytes each field
+// starts in and shifting it into place.
+
+
+#endif
+
+
+template <typename T>
+static interleaveKernel<T> selectInterleave()
+{
+#ifdef MIX_KERNELS_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		return { interleaveAvx2<T>, "AVX2" };
+	}
+	if (__builtin_cpu_supports("sse2")) {
+		return { interleaveSse2<T>, "SSE2" };
+	}
+#endif
+	return { interleaveScalar<T>, "scalar" };
+}
+// Description:
+// * Returns the fastest interleave() variant the CPU supports.
+
+
+template <typename T>
+static const interleaveKernel<T>& activeInterleave()
+{
+	static const interleaveKernel<T> KERNEL = selectInterleave<T>();
+	return KERNEL;
+}
+// Description:
+// * Returns the interleave() variant in use, selecting it on the first call.
+
+
+template <typename T>
+static unpackBitsKernel<T> selectUnpackBits()
+{
+	return { unpackBitsScalar<T>, "scalar" };
+}
+
+
+template <>
+unpackBitsKernel<int> selectUnpackBits<int>()
+{
+#ifdef MIX_KERNELS_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		return { unpackBitsAvx2, "AVX2" };
+	}
+#endif
+	return { unpackBitsScalar<int>, "scalar" };
+}
+// Description:
+// * Return the fastest unpackBits() variant the CPU supports for T.
+
+
+template <typename T>
+static const unpackBitsKernel<T>& activeUnpackBits()
+{
+	static const unpackBitsKernel<T> KERNEL = selectUnpackBits<T>();
+	return KERNEL;
+}
+// Description:
+// * Returns the unpackBits() variant in use, selecting it on the first call.
+
+
+template <typename T>
+void interleave(const T* even, const T* odd, T* out, std::size_t count)
+{
+	activeInterleave<T>().fn(even, odd, out, count);
+}
+
+
+template <typename T>
+void unpackBits(const std::uint64_t* words,
+				unsigned int width,
+				T base,
+				T* out,
+				std::size_t count)
+{
+	activeUnpackBits<T>().fn(words, width, base, out, count);
+}
+
+
+static const std::size_t COUNTING_SPAN = 256;
+static const std::size_t SMALL_SORT = 64;
+// std::sort is used below "SMALL_SORT" values, counting sort up to a span of
+// "COUNTING_SPAN" + 2 per value. See sortRun().
+
+
+template <typename T>
+static std::size_t countingSort(T* values,
+								std::size_t count,
+								std::uint64_t base,
+								std::uint64_t span,
+								bool unique)
+{
+	static thread_local std::vector<std::uint32_t> counts;
+	counts.assign(span + 1, 0);
+	for (std::size_t i = 0; i < count; ++i) {
+		++counts[static_cast<std::uint64_t>(values[i]) - base];
+	}
+
+	std::size_t out = 0;
+	for (std::uint64_t k = 0; k <= span; ++k) {
+		std::uint32_t c = counts[k];
+		if (unique && c) {
+			c = 1;
+		}
+		// unsigned arithmetic wraps instead of overflowing
+		const T VAL = static_cast<T>(base + k);
+		for (; c; --c) {
+			values[out++] = VAL;
+		}
+	}
+	return out;
+}
+// Description:
+// * Counting sorts the "count" values of "values", which lie in [base, base +
+// span] as 64-bit unsigned images. Writes each distinct value once if
+// "unique". Returns the amount of values written.
+
+
+template <typename T>
+static void radixSort(T* values, std::size_t count)
+{
+	const unsigned int DIGITS = sizeof(T);
+	const std::uint64_t FLIP = std::is_signed<T>::value ?
+							   std::uint64_t(1) << (8 * DIGITS - 1) : 0;
+	static thread_local std::vector<T> scratch;
+	if (scratch.size() < count) {
+		scratch.resize(count);
+	}
+
+	// every digit's histogram, in one pass
+	std::size_t histogram[DIGITS][256] = {};
+	for (std::size_t i = 0; i < count; ++i) {
+		const std::uint64_t KEY = static_cast<std::uint64_t>(values[i]) ^ FLIP;
+		for (unsigned int d = 0; d < DIGITS; ++d) {
+			++histogram[d][(KEY >> (8 * d)) & 0xff];
+		}
+	}
+
+	T* src = values;
+	T* dst = scratch.data();
+	for (unsigned int d = 0; d < DIGITS; ++d) {
+		std::size_t* bucket = histogram[d];
+		const std::uint64_t FIRST = static_cast<std::uint64_t>(src[0]) ^ FLIP;
+		if (bucket[(FIRST >> (8 * d)) & 0xff] == count) {
+			// every value shares this digit
+			continue;
+		}
+		std::size_t offset = 0;
+		for (unsigned int b = 0; b < 256; ++b) {
+			const std::size_t SIZE = bucket[b];
+			bucket[b] = offset;
+			offset += SIZE;
+		}
+		for (std::size_t i = 0; i < count; ++i) {
+			const std::uint64_t KEY = static_cast<std::uint64_t>(src[i]) ^ FLIP;
+			dst[bucket[(KEY >> (8 * d)) & 0xff]++] = src[i];
+		}
+		std::swap(src, dst);
+	}
+	if (src != values) {
+		std::copy(src, src + count, values);
+	}
+}
+// Description:
+// * LSD radix sorts the "count" values of "values", a byte per pass. Passes
+// over bytes every value shares are skipped.
+
+
+template <typename T>
+static std::size_t sortRun(T* values, std::size_t count, bool unique)
+{
+	if (count < SMALL_SORT) {
+		// clearing and scanning the counts costs more than sorting
+		std::sort(values, values + count);
+		return unique ? std::unique(values, values + count) - values : count;
+	}
+	auto bounds = std::minmax_element(values, values + count);
+	const std::uint64_t BASE = static_cast<std::uint64_t>(*bounds.first);
+	const std::uint64_t SPAN = static_cast<std::uint64_t>(*bounds.second) -
+							   BASE;
+	if (SPAN <= COUNTING_SPAN + 2 * static_cast<std::uint64_t>(count)) {
+		return countingSort(values, count, BASE, SPAN, unique);
+	}
+	radixSort(values, count);
+	return unique ? std::unique(values, values + count) - values : count;
+}
+// Description:
+// * Sorts the "count" values of "values" by the cheapest method for their
+// span and count, dropping duplicates if "unique". Returns the amount of
+// values kept.
+
+
+template <typename T>
+void sortValues(T* values, std::size_t count)
+{
+	sortRun(values, count, false);
+}
+
+
+template <typename T>
+std::size_t sortUniqueValues(T* values, std::size_t count)
+{
+	return sortRun(values, count, true);
+}
+
+
+const char* interleaveKernelName()
+{
+	return activeInterleave<int>().name;
+}
+
+
+const char* unpackBitsKernelName()
+{
+	return activeUnpackBits<int>().name;
+}
+
+
+template void interleave(const std::int16_t*, const std::int16_t*,
+						 std::int16_t*, std::size_t);
+template void interleave(const int*, const int*, int*, std::size_t);
+template void interleave(const std::int64_t*, const std::int64_t*,
+						 std::int64_t*, std::size_t);
+template void interleaveScalar(const std::int16_t*, const std::int16_t*,
+							   std::int16_t*, std::size_t);
+template void interleaveScalar(const int*, const int*, int*, std::size_t);
+template void interleaveScalar(const std::int64_t*, const std::int64_t*,
+							   std::int64_t*, std::size_t);
+template void unpackBits(const std::uint64_t*, unsigned int, std::int16_t,
+						 std::int16_t*, std::size_t);
+template void unpackBits(const std::uint64_t*, unsigned int, int, int*,
+						 std::size_t);
+template void unpackBits(const std::uint64_t*, unsigned int, std::int64_t,
+						 std::int64_t*, std::size_t);
+template void unpackBitsScalar(const std::uint64_t*, unsigned int,
+							   std::int16_t, std::int16_t*, std::size_t);
+template void unpackBitsScalar(const std::uint64_t*, unsigned int, int, int*,
+							   std::size_t);
+template void unpackBitsScalar(const std::uint64_t*, unsigned int,
+							   std::int64_t, std::int64_t*, std::size_t);
+template void sortValues(std::int16_t*, std::size_t);
+template void sortValues(int*, std::size_t);
+template void sortValues(std::int64_t*, std::size_t);
+template std::size_t sortUniqueValues(std::int16_t*, std::size_t);
+template std::size_t sortUniqueValues(int*, std::size_t);
+template std::size_t sortUniqueValues(std::int64_t*, std::size_t);
+// Description:
+// * Instantiates the kernels for the value types of the mixers.
\ No newline at end of file
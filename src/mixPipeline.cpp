@@ -0,0 +1,321 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: mixPipeline.cpp
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Implementation Invariant:
+// * apply() runs every stage over a block before moving on to the next. The
+// first stage moves the block's values behind the values kept so far, later
+// stages compact it in place. Writes never pass reads, so compaction needs no
+// second buffer.
+// * Filters compact by storing every value and only advancing the write
+// position past those kept, so they do not branch on the values.
+// * Duplicates are found through open addressing hash tables, with
+// Fibonacci hashing: the top bits of the value times 2^64 / phi pick the
+// slot.
+// * Small pings use a 64-slot table on the stack, with a bit per slot telling
+// whether it is taken, so emptying it is clearing one word.
+// * Larger pings use a table with a stamp per slot. A slot is taken only if
+// its stamp is that of the current apply(), so the table is emptied by
+// bumping the stamp, not by clearing it. The table is thread_local, and grows
+// to the largest ping of the thread, so steady-state pings do not allocate.
+
+
+#include <algorithm>  // fill, min
+#include <cstddef>  // size_t
+#include <cstdint>  // int16_t, int64_t, uint32_t, uint64_t
+#include <utility>  // move
+#include <vector>  // vector
+
+
+#include "../include/mixPipeline.h"
+#include "../include/mixValue.h"
+
+
+template <typename T>
+static std::size_t fibonacciSlot(T val, unsigned int bits)
+{
+	return (static_cast<std::uint64_t>(val) * 0x9e3779b97f4a7c15ULL) >>
+		   (64 - bits);
+}
+// Description:
+// * Returns the slot of "val" in a table of 2^"bits" slots.
+
+
+template <typename T>
+struct dedupSet
+{
+	std::vector<T> slots;
+	std::vector<std::uint32_t> stamps;
+	std::uint32_t stamp;
+	unsigned int bits;
+
+	dedupSet():
+		stamp(0),
+		bits(0)
+	{
+	}
+
+	void reset(std::size_t size)
+	{
+		bits = 7;
+		while ((std::size_t(1) << bits) < 2 * size) {
+			++bits;
+		}
+		const std::size_t CAPACITY = std::size_t(1) << bits;
+		if (CAPACITY > slots.size()) {
+			slots.assign(CAPACITY, T());
+			stamps.assign(CAPACITY, 0);
+			stamp = 0;
+		}
+		if (++stamp == 0) {
+			std::fill(stamps.begin(), stamps.end(), 0);
+			stamp = 1;
+		}
+	}
+
+	bool insert(T val)
+	{
+		const std::size_t MASK = (std::size_t(1) << bits) - 1;
+		std::size_t slot = fibonacciSlot(val, bits);
+		while (stamps[slot] == stamp) {
+			if (slots[slot] == val) {
+				return false;
+			}
+			slot = (slot + 1) & MASK;
+		}
+		stamps[slot] = stamp;
+		slots[slot] = val;
+		return true;
+	}
+};
+// Description:
+// * Hash set of the values kept by a dedup apply(). reset() empties it for a
+// ping of "size" values, keeping it at most half full. insert() returns
+// whether "val" was not in the set yet.
+
+
+template <typename T, typename Keep>
+static std::size_t compact(const T* in, T* out, std::size_t count, Keep keep)
+{
+	std::size_t kept = 0;
+	for (std::size_t i = 0; i < count; ++i) {
+		const T VAL = in[i];
+		out[kept] = VAL;
+		kept += keep(VAL);
+	}
+	return kept;
+}
+// Description:
+// * Stores the values of "in" that "keep" returns true for into "out", in
+// order, and returns their amount. "out" must not be past "in".
+
+
+template <typename T>
+struct smallDedupSet
+{
+	T slots[64];
+	std::uint64_t taken;
+
+	smallDedupSet():
+		taken(0)
+	{
+	}
+
+	bool insert(T val)
+	{
+		unsigned int slot = fibonacciSlot(val, 6);
+		while ((taken >> slot) & 1) {
+			if (slots[slot] == val) {
+				return false;
+			}
+			slot = (slot + 1) & 63;
+		}
+		taken |= std::uint64_t(1) << slot;
+		slots[slot] = val;
+		return true;
+	}
+};
+// Description:
+// * Hash set of the values kept by a dedup apply() of at most 64 values, on
+// the stack. insert() returns whether "val" was not in the set yet.
+
+
+template <typename T>
+const std::size_t basicMixPipeline<T>::_BLOCK;
+
+
+template <typename T>
+const std::size_t basicMixPipeline<T>::_SMALL_DEDUP;
+
+
+template <typename T>
+basicMixPipeline<T>::basicMixPipeline():
+	_stages(),
+	_dedup(false)
+{
+}
+
+
+template <typename T>
+basicMixPipeline<T> basicMixPipeline<T>::primePurge()
+{
+	return basicMixPipeline().dropPrimes();
+}
+
+
+template <typename T>
+basicMixPipeline<T> basicMixPipeline<T>::duplicatePurge()
+{
+	return basicMixPipeline().setDedup();
+}
+
+
+template <typename T>
+std::size_t basicMixPipeline<T>::apply(T* values, std::size_t size,
+									   bool dedup) const
+{
+	dedup |= _dedup;
+	if (_stages.empty() && !dedup) {
+		return size;
+	}
+
+	static thread_local dedupSet<T> seen;
+	smallDedupSet<T> smallSeen;
+	const bool SMALL = size <= _SMALL_DEDUP;
+	if (dedup && !SMALL) {
+		seen.reset(size);
+	}
+
+	std::size_t kept = 0;
+	for (std::size_t first = 0; first < size; first += _BLOCK) {
+		const T* in = values + first;
+		T* out = values + kept;
+		std::size_t count = std::min(_BLOCK, size - first);
+		for (const stage& rStage : _stages) {
+			count = runStage(rStage, in, out, count);
+			in = out;
+		}
+		if (!dedup) {
+			kept += count;
+		} else if (SMALL) {
+			kept += compact(in, out, count, [&smallSeen](T val) {
+				return smallSeen.insert(val);
+			});
+		} else {
+			kept += compact(in, out, count,
+							[](T val) { return seen.insert(val); });
+		}
+	}
+	return kept;
+}
+
+
+template <typename T>
+basicMixPipeline<T>& basicMixPipeline<T>::keepEven()
+{
+	return addStage(EVEN);
+}
+
+
+template <typename T>
+basicMixPipeline<T>& basicMixPipeline<T>::keepOdd()
+{
+	return addStage(ODD);
+}
+
+
+template <typename T>
+basicMixPipeline<T>& basicMixPipeline<T>::dropPrimes()
+{
+	return addStage(NO_PRIMES);
+}
+
+
+template <typename T>
+basicMixPipeline<T>& basicMixPipeline<T>::keepRange(T low, T high)
+{
+	addStage(RANGE);
+	_stages.back().low = low;
+	_stages.back().high = high;
+	return *this;
+}
+
+
+template <typename T>
+basicMixPipeline<T>& basicMixPipeline<T>::keepIf(Filter filter)
+{
+	addStage(FILTER);
+	_stages.back().filter = std::move(filter);
+	return *this;
+}
+
+
+template <typename T>
+basicMixPipeline<T>& basicMixPipeline<T>::transform(Transform fn)
+{
+	addStage(TRANSFORM);
+	_stages.back().transform = std::move(fn);
+	return *this;
+}
+
+
+template <typename T>
+basicMixPipeline<T>& basicMixPipeline<T>::setDedup(bool dedup)
+{
+	_dedup = dedup;
+	return *this;
+}
+
+
+template <typename T>
+std::size_t basicMixPipeline<T>::runStage(const stage& rStage, const T* in,
+										  T* out, std::size_t count)
+{
+	switch (rStage.kind) {
+		case EVEN:
+			return compact(in, out, count, [](T val) {
+				return !mixValueTraits<T>::isOdd(val);
+			});
+		case ODD:
+			return compact(in, out, count, [](T val) {
+				return mixValueTraits<T>::isOdd(val);
+			});
+		case NO_PRIMES:
+			return compact(in, out, count, [](T val) {
+				return !mixValueTraits<T>::isPrime(val);
+			});
+		case RANGE:
+			return compact(in, out, count, [&rStage](T val) {
+				return !(val < rStage.low) && !(rStage.high < val);
+			});
+		case FILTER:
+			return compact(in, out, count, [&rStage](T val) {
+				return rStage.filter(val);
+			});
+		case TRANSFORM:
+			for (std::size_t i = 0; i < count; ++i) {
+				out[i] = rStage.transform(in[i]);
+			}
+			return count;
+	}
+	return count;
+}
+
+
+template <typename T>
+basicMixPipeline<T>& basicMixPipeline<T>::addStage(StageKind kind)
+{
+	stage newStage;
+	newStage.kind = kind;
+	newStage.low = T();
+	newStage.high = T();
+	_stages.push_back(std::move(newStage));
+	return *this;
+}
+
+
+template class basicMixPipeline<std::int16_t>;
+template class basicMixPipeline<int>;
+template class basicMixPipeline<std::int64_t>;
\ No newline at end of file
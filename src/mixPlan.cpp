@@ -0,0 +1,88 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: mixPlan.cpp
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Implementation Invariant:
+// * Source "s" pulls "weights[s]" * "rounds" values per ping, stored from
+// "_pullOffsets[s]" on. Round "r" of source "s" uses the values from
+// "_pullOffsets[s]" + r * "weights[s]" on.
+// * Every pulled value is gathered exactly once, so "_gather" is a
+// permutation of the pull buffer indexes.
+
+
+#include <vector>  // vector
+
+
+#include "../include/mixPlan.h"
+
+
+mixPlan::mixPlan():
+	_pattern(CONCATENATE),
+	_dedup(false),
+	_pullCounts(),
+	_pullOffsets(),
+	_gather()
+{
+}
+
+
+mixPlan::mixPlan(Pattern pattern,
+				 const std::vector<unsigned int>& weights,
+				 unsigned int rounds,
+				 bool dedup):
+	_pattern(pattern),
+	_dedup(dedup),
+	_pullCounts(weights.size()),
+	_pullOffsets(weights.size()),
+	_gather()
+{
+	const unsigned int SOURCES = weights.size();
+
+	// lay out the pull buffer
+	unsigned int total = 0;
+	for (unsigned int s = 0; s < SOURCES; ++s) {
+		_pullCounts[s] = weights[s] * rounds;
+		_pullOffsets[s] = total;
+		total += _pullCounts[s];
+	}
+	_gather.reserve(total);
+
+	// compile the pattern
+	switch (_pattern) {
+		case ROUND_ROBIN: {
+			std::vector<unsigned int> taken(SOURCES);
+			for (unsigned int r = 0; r < rounds; ++r) {
+				taken.assign(SOURCES, 0);
+				bool more = true;
+				while (more) {
+					more = false;
+					for (unsigned int s = 0; s < SOURCES; ++s) {
+						if (taken[s] < weights[s]) {
+							_gather.push_back(_pullOffsets[s] +
+											  r * weights[s] + taken[s]);
+							++taken[s];
+							more = true;
+						}
+					}
+				}
+			}
+			break;
+		}
+		case BLOCKS:
+			for (unsigned int r = 0; r < rounds; ++r) {
+				for (unsigned int s = 0; s < SOURCES; ++s) {
+					for (unsigned int i = 0; i < weights[s]; ++i) {
+						_gather.push_back(_pullOffsets[s] + r * weights[s] + i);
+					}
+				}
+			}
+			break;
+		case CONCATENATE:
+			for (unsigned int i = 0; i < total; ++i) {
+				_gather.push_back(i);
+			}
+			break;
+	}
+}
@@ -0,0 +1,469 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: mixRecorder.cpp
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Implementation Invariant:
+// * Every operation is recorded before it is performed, so the log stays in
+// operation order even if the operation draws from the rngs.
+// * numMixer::_eng is seeded with the session seed, multiMix::_eng with its
+// mixHash(), so the two rngs do not draw the same stream.
+// * The log buffer is written out once it holds FLUSH_SIZE bytes.
+// * mixReplayer checks every id and count before performing an operation, so
+// a malformed log fails instead of corrupting the session.
+
+
+#include <cstddef>  // size_t
+#include <cstdint>  // uint32_t, uint64_t, int64_t
+#include <istream>  // istream
+#include <ostream>  // ostream
+#include <streambuf>  // streambuf
+#include <string>  // string, to_string
+#include <vector>  // vector
+
+
+#include "../include/dubMix.h"
+#include "../include/mixHash.h"
+#include "../include/mixRecorder.h"
+#include "../include/multiMix.h"
+#include "../include/numMixer.h"
+
+
+enum Opcode {
+	OP_END,
+	OP_CREATE_NUM_MIXER,
+	OP_CREATE_DUB_MIX,
+	OP_CREATE_MULTI_MIX,
+	OP_SET_CONTROLLER_STATE,
+	OP_PING_NUM_MIXER,
+	OP_SET_CTL,
+	OP_PING_DUB_MIX,
+	OP_ADD_NUM_MIXERS,
+	OP_ADD_NUM_MIXERS_PARALLEL,
+	OP_REMOVE_NUM_MIXERS,
+	OP_SET_SCHEDULE_POLICY,
+	OP_PING_MULTI_MIX
+};
+// Description:
+// * Log record types. Append only, so older logs stay readable.
+
+
+static const char MAGIC[4] = { 'M', 'X', 'L', 'G' };
+// Marks the start of a log.
+
+
+static const std::uint64_t VERSION = 1;
+// Log format version.
+
+
+static const std::size_t FLUSH_SIZE = 1 << 16;
+// Size the log buffer is written out at.
+
+
+static const std::uint64_t MAX_SIZE = 1 << 24;
+// Largest ping size or count accepted from a log.
+
+
+mixRecorder::mixRecorder(std::ostream* log, std::uint32_t seed):
+	_log(log),
+	_buffer(),
+	_seed(seed),
+	_operations(0),
+	_checksum(0),
+	_numMixers(),
+	_dubMixes(),
+	_multiMixes()
+{
+	numMixer::seed(_seed);
+	multiMix::seed(mixHash(_seed));
+	if (_log) {
+		_buffer.reserve(FLUSH_SIZE + 64);
+		_buffer.insert(_buffer.end(), MAGIC, MAGIC + sizeof(MAGIC));
+		writeVarint(VERSION);
+		writeVarint(_seed);
+	}
+}
+
+
+mixRecorder::~mixRecorder()
+{
+	finish();
+}
+
+
+unsigned int mixRecorder::createNumMixer(const std::vector<int>& dataset)
+{
+	writeOp(OP_CREATE_NUM_MIXER);
+	writeVarint(dataset.size());
+	for (auto val : dataset) {
+		writeSigned(val);
+	}
+	_numMixers.emplace_back(dataset);
+	return _numMixers.size() - 1;
+}
+
+
+unsigned int mixRecorder::createDubMix()
+{
+	writeOp(OP_CREATE_DUB_MIX);
+	_dubMixes.emplace_back();
+	return _dubMixes.size() - 1;
+}
+
+
+unsigned int mixRecorder::createMultiMix()
+{
+	writeOp(OP_CREATE_MULTI_MIX);
+	_multiMixes.emplace_back();
+	return _multiMixes.size() - 1;
+}
+
+
+void mixRecorder::setControllerState(unsigned int id,
+									 numMixer::OutputController state)
+{
+	writeOp(OP_SET_CONTROLLER_STATE);
+	writeVarint(id);
+	writeVarint(state);
+	_numMixers[id].setControllerState(state);
+}
+
+
+bool mixRecorder::pingNumMixer(unsigned int id, std::vector<int>& returnValues)
+{
+	writeOp(OP_PING_NUM_MIXER);
+	writeVarint(id);
+	writeVarint(returnValues.size());
+	bool pinged = _numMixers[id].ping(returnValues);
+	checksumValues(returnValues.data(), returnValues.size(), pinged);
+	return pinged;
+}
+
+
+void mixRecorder::setCtl(unsigned int id, unsigned int ctl)
+{
+	writeOp(OP_SET_CTL);
+	writeVarint(id);
+	writeVarint(ctl);
+	_dubMixes[id].setCtl(ctl);
+}
+
+
+mixResult mixRecorder::pingDubMix(unsigned int id, unsigned int size)
+{
+	writeOp(OP_PING_DUB_MIX);
+	writeVarint(id);
+	writeVarint(size);
+	mixResult returnset = _dubMixes[id].ping(size);
+	checksumValues(returnset.data(), returnset.size(), true);
+	return returnset;
+}
+
+
+void mixRecorder::addNumMixers(unsigned int id, unsigned int count)
+{
+	writeOp(OP_ADD_NUM_MIXERS);
+	writeVarint(id);
+	writeVarint(count);
+	_multiMixes[id].addNumMixers(count);
+}
+
+
+void mixRecorder::addNumMixersParallel(unsigned int id,
+									   unsigned int count,
+									   unsigned int threadCount)
+{
+	writeOp(OP_ADD_NUM_MIXERS_PARALLEL);
+	writeVarint(id);
+	writeVarint(count);
+	writeVarint(threadCount);
+	_multiMixes[id].addNumMixersParallel(count, threadCount);
+}
+
+
+void mixRecorder::removeNumMixers(unsigned int id, unsigned int count)
+{
+	writeOp(OP_REMOVE_NUM_MIXERS);
+	writeVarint(id);
+	writeVarint(count);
+	_multiMixes[id].removeNumMixers(count);
+}
+
+
+void mixRecorder::setSchedulePolicy(unsigned int id,
+									multiMix::SchedulePolicy policy)
+{
+	writeOp(OP_SET_SCHEDULE_POLICY);
+	writeVarint(id);
+	writeVarint(policy);
+	_multiMixes[id].setSchedulePolicy(policy);
+}
+
+
+mixResult mixRecorder::pingMultiMix(unsigned int id)
+{
+	writeOp(OP_PING_MULTI_MIX);
+	writeVarint(id);
+	mixResult returnset = _multiMixes[id].ping();
+	checksumValues(returnset.data(), returnset.size(), true);
+	return returnset;
+}
+
+
+void mixRecorder::finish()
+{
+	if (_log) {
+		writeVarint(OP_END);
+		writeVarint(_operations);
+		writeVarint(_checksum);
+		flushBuffer();
+		_log->flush();
+		_log = nullptr;
+	}
+}
+
+
+void mixRecorder::writeVarint(std::uint64_t val)
+{
+	if (_log) {
+		while (val >= 0x80) {
+			_buffer.push_back(static_cast<unsigned char>(val | 0x80));
+			val >>= 7;
+		}
+		_buffer.push_back(static_cast<unsigned char>(val));
+	}
+}
+
+
+void mixRecorder::writeSigned(std::int64_t val)
+{
+	// zigzag, so small negative values stay short
+	writeVarint((static_cast<std::uint64_t>(val) << 1) ^
+				static_cast<std::uint64_t>(val >> 63));
+}
+
+
+void mixRecorder::writeOp(unsigned int opcode)
+{
+	++_operations;
+	if (_log) {
+		if (_buffer.size() >= FLUSH_SIZE) {
+			flushBuffer();
+		}
+		writeVarint(opcode);
+	}
+}
+
+
+void mixRecorder::flushBuffer()
+{
+	_log->write(reinterpret_cast<const char*>(_buffer.data()), _buffer.size());
+	_buffer.clear();
+}
+
+
+void mixRecorder::checksumValues(const int* values,
+								 std::size_t count,
+								 bool pinged)
+{
+	_checksum = hashCombine(_checksum, pinged ? count : ~0ULL);
+	for (std::size_t i = 0; i < count; ++i) {
+		_checksum = hashCombine(_checksum,
+								static_cast<std::uint32_t>(values[i]));
+	}
+}
+
+
+mixReplayer::mixReplayer(std::istream& log):
+	_log(log),
+	_seed(0),
+	_operations(0),
+	_checksum(0),
+	_recordedChecksum(0),
+	_error()
+{
+}
+
+
+bool mixReplayer::run()
+{
+	std::streambuf* in = _log.rdbuf();
+	for (auto c : MAGIC) {
+		if (in->sbumpc() != c) {
+			return fail("not a mixer log");
+		}
+	}
+	std::uint64_t version, seed;
+	if (!readVarint(version) || version != VERSION) {
+		return fail("unsupported log version");
+	}
+	if (!readVarint(seed)) {
+		return fail("truncated header");
+	}
+	_seed = seed;
+
+	mixRecorder session(nullptr, _seed);
+	std::vector<int> returnValues;
+	std::uint64_t opcode, id, arg, arg2;
+	auto readId = [&](std::size_t count) {
+		return readVarint(id) && id < count;
+	};
+	auto readSize = [&](std::uint64_t& val) {
+		return readVarint(val) && val <= MAX_SIZE;
+	};
+	auto failAt = [&](const std::string& reason) {
+		return fail(reason + " at operation " +
+					std::to_string(session.operations() + 1));
+	};
+	for (;;) {
+		if (!readVarint(opcode)) {
+			return fail("truncated log, no trailer");
+		}
+		switch (opcode) {
+			case OP_END: {
+				std::uint64_t recordedOperations;
+				if (!readVarint(recordedOperations) ||
+					!readVarint(_recordedChecksum)) {
+					return fail("truncated trailer");
+				}
+				_operations = session.operations();
+				_checksum = session.checksum();
+				if (recordedOperations != _operations) {
+					return fail("operation count mismatch");
+				}
+				if (_recordedChecksum != _checksum) {
+					return fail("checksum mismatch, output diverged");
+				}
+				return true;
+			}
+			case OP_CREATE_NUM_MIXER: {
+				if (!readSize(arg) || arg == 0) {
+					return failAt("bad dataset size");
+				}
+				std::vector<int> dataset(arg);
+				for (auto& val : dataset) {
+					std::int64_t sval;
+					if (!readSigned(sval)) {
+						return failAt("truncated dataset");
+					}
+					val = static_cast<int>(sval);
+				}
+				session.createNumMixer(dataset);
+				break;
+			}
+			case OP_CREATE_DUB_MIX:
+				session.createDubMix();
+				break;
+			case OP_CREATE_MULTI_MIX:
+				session.createMultiMix();
+				break;
+			case OP_SET_CONTROLLER_STATE:
+				if (!readId(session.numMixerCount()) ||
+					!readVarint(arg) || arg > numMixer::ODD) {
+					return failAt("bad controller state");
+				}
+				session.setControllerState(
+						id, static_cast<numMixer::OutputController>(arg));
+				break;
+			case OP_PING_NUM_MIXER:
+				if (!readId(session.numMixerCount()) || !readSize(arg)) {
+					return failAt("bad numMixer ping");
+				}
+				returnValues.resize(arg);
+				session.pingNumMixer(id, returnValues);
+				break;
+			case OP_SET_CTL:
+				if (!readId(session.dubMixCount()) || !readVarint(arg) ||
+					arg < 1 || arg > 4) {
+					return failAt("bad ctl");
+				}
+				session.setCtl(id, arg);
+				break;
+			case OP_PING_DUB_MIX:
+				if (!readId(session.dubMixCount()) || !readSize(arg)) {
+					return failAt("bad dubMix ping");
+				}
+				session.pingDubMix(id, arg);
+				break;
+			case OP_ADD_NUM_MIXERS:
+				if (!readId(session.multiMixCount()) || !readSize(arg)) {
+					return failAt("bad add");
+				}
+				session.addNumMixers(id, arg);
+				break;
+			case OP_ADD_NUM_MIXERS_PARALLEL:
+				if (!readId(session.multiMixCount()) || !readSize(arg) ||
+					!readVarint(arg2)) {
+					return failAt("bad parallel add");
+				}
+				// the result does not depend on the thread count
+				session.addNumMixersParallel(id, arg, 0);
+				break;
+			case OP_REMOVE_NUM_MIXERS:
+				if (!readId(session.multiMixCount()) || !readVarint(arg) ||
+					arg > static_cast<std::uint64_t>(
+							session.getMultiMix(id).getNumMixerCount())) {
+					return failAt("bad remove");
+				}
+				session.removeNumMixers(id, arg);
+				break;
+			case OP_SET_SCHEDULE_POLICY:
+				if (!readId(session.multiMixCount()) || !readVarint(arg) ||
+					arg > multiMix::LEAST_RECENTLY_USED) {
+					return failAt("bad schedule policy");
+				}
+				session.setSchedulePolicy(
+						id, static_cast<multiMix::SchedulePolicy>(arg));
+				break;
+			case OP_PING_MULTI_MIX:
+				if (!readId(session.multiMixCount()) ||
+					(session.getMultiMix(id).schedulePolicy() ==
+						multiMix::STACK &&
+					 !session.getMultiMix(id).hasNumMixers())) {
+					return failAt("bad multiMix ping");
+				}
+				session.pingMultiMix(id);
+				break;
+			default:
+				return failAt("unknown opcode");
+		}
+	}
+}
+
+
+bool mixReplayer::readVarint(std::uint64_t& val)
+{
+	std::streambuf* in = _log.rdbuf();
+	val = 0;
+	for (unsigned int shift = 0; shift < 64; shift += 7) {
+		int byte = in->sbumpc();
+		if (byte == std::streambuf::traits_type::eof()) {
+			return false;
+		}
+		val |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+		if (!(byte & 0x80)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+
+bool mixReplayer::readSigned(std::int64_t& val)
+{
+	std::uint64_t zigzag;
+	if (!readVarint(zigzag)) {
+		return false;
+	}
+	val = static_cast<std::int64_t>(zigzag >> 1) ^
+		  -static_cast<std::int64_t>(zigzag & 1);
+	return true;
+}
+
+
+bool mixReplayer::fail(const std::string& reason)
+{
+	_error = reason;
+	return false;
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: mixResult.cpp
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Implementation Invariant:
+// * "_data" == "_inline" exactly when the values are stored inline, and then
+// "_capacity" == INLINE_CAPACITY.
+// * Moving from a result leaves it inline and empty.
+
+
+#include <algorithm>  // copy
+#include <cstddef>  // size_t
+#include <cstdint>  // int16_t, int64_t
+#include <initializer_list>  // initializer_list
+#include <utility>  // move
+
+
+#include "../include/mixResult.h"
+
+
+template <typename T>
+const std::size_t basicMixResult<T>::INLINE_CAPACITY;
+
+
+template <typename T>
+basicMixResult<T>::basicMixResult(std::initializer_list<T> values):
+	basicMixResult()
+{
+	reserve(values.size());
+	std::copy(values.begin(), values.end(), _data);
+	_size = values.size();
+}
+
+
+template <typename T>
+basicMixResult<T>::basicMixResult(const basicMixResult& obj):
+	basicMixResult()
+{
+	reserve(obj._size);
+	std::copy(obj.begin(), obj.end(), _data);
+	_size = obj._size;
+}
+
+
+template <typename T>
+basicMixResult<T>::basicMixResult(basicMixResult&& obj) noexcept:
+	basicMixResult()
+{
+	*this = std::move(obj);
+}
+
+
+template <typename T>
+basicMixResult<T>& basicMixResult<T>::operator=(const basicMixResult& obj)
+{
+	if (this != &obj) {
+		reserve(obj._size);
+		std::copy(obj.begin(), obj.end(), _data);
+		_size = obj._size;
+	}
+	return *this;
+}
+
+
+template <typename T>
+basicMixResult<T>& basicMixResult<T>::operator=(
+		basicMixResult&& obj) noexcept
+{
+	if (this == &obj) {
+		return *this;
+	}
+	if (obj.isInline()) {
+		// values fit inline here too, unless this result already spilled
+		std::copy(obj.begin(), obj.end(), _data);
+	} else {
+		if (!isInline()) {
+			delete[] _data;
+		}
+		_data = obj._data;
+		_capacity = obj._capacity;
+		obj._data = obj._inline;
+		obj._capacity = INLINE_CAPACITY;
+	}
+	_size = obj._size;
+	obj._size = 0;
+	return *this;
+}
+
+
+template <typename T>
+void basicMixResult<T>::grow(std::size_t capacity)
+{
+	T* data = new T[capacity];
+	std::copy(begin(), end(), data);
+	if (!isInline()) {
+		delete[] _data;
+	}
+	_data = data;
+	_capacity = capacity;
+}
+
+
+template class basicMixResult<std::int16_t>;
+template class basicMixResult<int>;
+template class basicMixResult<std::int64_t>;
\ No newline at end of file
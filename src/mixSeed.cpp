@@ -0,0 +1,27 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: mixSeed.cpp
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Implementation Invariant:
+// * Only processId() needs a platform header, so it is the only helper
+// defined here, the rest are inline in mixSeed.h.
+
+
+#if defined(__unix__)
+#include <unistd.h>  // getpid
+#endif
+
+
+#include "../include/mixSeed.h"
+
+
+unsigned int processId()
+{
+#if defined(__unix__)
+	return static_cast<unsigned int>(getpid());
+#else
+	return 0;
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,234 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: mixTopology.cpp
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Implementation Invariant:
+// * Every way of making a topology goes through parse(), or falls back to the
+// default topology, so the class invariant holds.
+// * Pinning is only implemented on Linux (pthread_setaffinity_np). Elsewhere
+// the pin functions return false.
+
+
+#include <algorithm>  // max
+#include <cstddef>  // size_t
+#include <cstdlib>  // strtoul
+#include <fstream>  // ifstream
+#include <sstream>  // ostringstream
+#include <string>  // string, to_string
+#include <thread>  // hardware_concurrency
+#include <vector>  // vector
+
+
+#if defined(__linux__)
+#include <pthread.h>  // pthread_self, pthread_setaffinity_np
+#include <sched.h>  // cpu_set_t, CPU_ZERO, CPU_SET
+#endif
+
+
+#include "../include/mixTopology.h"
+
+
+#if defined(__linux__)
+static const unsigned long CPU_LIMIT = CPU_SETSIZE;
+#else
+static const unsigned long CPU_LIMIT = 1024;
+#endif
+// Cpus are numbered below this, the most a cpu_set_t can hold.
+
+
+static bool parseCpuList(const std::string& list,
+						 std::vector<unsigned int>& cpus)
+{
+	std::size_t pos = 0;
+	while (pos < list.size()) {
+		std::size_t end = list.find(',', pos);
+		if (end == std::string::npos) {
+			end = list.size();
+		}
+		std::string item = list.substr(pos, end - pos);
+		std::size_t dash = item.find('-');
+		char* rest = 0;
+		unsigned long first = std::strtoul(item.c_str(), &rest, 10);
+		if (rest == item.c_str()) {
+			return false;
+		}
+		unsigned long last = first;
+		if (dash != std::string::npos) {
+			const char* lastText = item.c_str() + dash + 1;
+			last = std::strtoul(lastText, &rest, 10);
+			if (rest == lastText || last < first) {
+				return false;
+			}
+		}
+		if (last >= CPU_LIMIT) {
+			return false;
+		}
+		for (unsigned long cpu = first; cpu <= last; ++cpu) {
+			cpus.push_back(cpu);
+		}
+		pos = end + 1;
+	}
+	return true;
+}
+// Description:
+// * Appends the cpus of a list such as "0-3,8" to "cpus". Returns false if
+// "list" is malformed, or names a cpu of CPU_LIMIT or above.
+
+
+mixTopology::mixTopology():
+	_nodes(1),
+	_simulated(false)
+{
+	unsigned int cpuCount = std::max(1u, std::thread::hardware_concurrency());
+	for (unsigned int cpu = 0; cpu < cpuCount; ++cpu) {
+		_nodes[0].push_back(cpu);
+	}
+}
+
+
+mixTopology mixTopology::detect()
+{
+	std::string config;
+#if defined(__linux__)
+	for (unsigned int node = 0; ; ++node) {
+		std::ifstream ifs("/sys/devices/system/node/node" +
+						  std::to_string(node) + "/cpulist");
+		std::string list;
+		if (!ifs || !std::getline(ifs, list)) {
+			break;
+		}
+		if (list.empty()) {
+			// memory-only node
+			continue;
+		}
+		config += (config.empty() ? "" : ";") + list;
+	}
+#endif
+	return parse(config);
+}
+
+
+mixTopology mixTopology::simulated(unsigned int nodeCount)
+{
+	const unsigned int CPU_COUNT = std::max(1u,
+		std::thread::hardware_concurrency());
+	nodeCount = std::max(1u, nodeCount);
+	std::string config;
+	for (unsigned int node = 0; node < nodeCount; ++node) {
+		unsigned int first = CPU_COUNT * node / nodeCount;
+		unsigned int last = CPU_COUNT * (node + 1) / nodeCount;
+		if (last == first) {
+			// fewer cpus than nodes
+			first %= CPU_COUNT;
+			last = first + 1;
+		}
+		config += (node ? ";" : "") + std::to_string(first) + "-" +
+				  std::to_string(last - 1);
+	}
+	return parse(config, true);
+}
+
+
+mixTopology mixTopology::parse(const std::string& config, bool simulated)
+{
+	mixTopology topology;
+	std::vector<std::vector<unsigned int> > nodes;
+	std::size_t pos = 0;
+	while (pos < config.size()) {
+		std::size_t end = config.find(';', pos);
+		if (end == std::string::npos) {
+			end = config.size();
+		}
+		std::vector<unsigned int> cpus;
+		if (!parseCpuList(config.substr(pos, end - pos), cpus) ||
+			cpus.empty()) {
+			return topology;
+		}
+		nodes.push_back(cpus);
+		pos = end + 1;
+	}
+	if (!nodes.empty()) {
+		topology._nodes.swap(nodes);
+		topology._simulated = simulated;
+	}
+	return topology;
+}
+
+
+bool mixTopology::pinThread(unsigned int node) const
+{
+#if defined(__linux__)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for (unsigned int cpu : _nodes[node]) {
+		if (cpu < CPU_SETSIZE) {
+			CPU_SET(cpu, &set);
+		}
+	}
+	return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+	return false;
+#endif
+}
+
+
+bool mixTopology::pinThreadToCpu(unsigned int cpu)
+{
+#if defined(__linux__)
+	if (cpu >= CPU_SETSIZE) {
+		return false;
+	}
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+	return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+	return false;
+#endif
+}
+
+
+unsigned int mixTopology::cpuCount() const
+{
+	unsigned int count = 0;
+	for (const auto& node : _nodes) {
+		count += node.size();
+	}
+	return count;
+}
+
+
+unsigned int mixTopology::nodeOfCpu(unsigned int index) const
+{
+	unsigned int node = 0;
+	while (index >= _nodes[node].size()) {
+		index -= _nodes[node].size();
+		++node;
+	}
+	return node;
+}
+
+
+unsigned int mixTopology::cpu(unsigned int index) const
+{
+	unsigned int node = nodeOfCpu(index);
+	for (unsigned int i = 0; i < node; ++i) {
+		index -= _nodes[i].size();
+	}
+	return _nodes[node][index];
+}
+
+
+std::string mixTopology::toString() const
+{
+	std::ostringstream oss;
+	for (unsigned int node = 0; node < _nodes.size(); ++node) {
+		oss << (node ? ";" : "");
+		for (unsigned int i = 0; i < _nodes[node].size(); ++i) {
+			oss << (i ? "," : "") << _nodes[node][i];
+		}
+	}
+	return oss.str();
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: mixValue.cpp
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Implementation Invariant:
+// * The 16-bit sieve is built on first use, in a function-local static whose
+// initialization is thread-safe.
+// * Miller-Rabin multiplies modulo n in 64 bits for 32-bit values, and in 128
+// bits (a GCC extension) for 64-bit values.
+
+
+#include <cstdint>  // uint16_t, uint32_t, uint64_t
+#include <vector>  // vector
+
+
+#include "../include/mixValue.h"
+
+
+__extension__ typedef unsigned __int128 uint128;
+
+
+static std::vector<bool> sieve16()
+{
+	const std::uint32_t SIZE = 1u << 16;
+	std::vector<bool> prime(SIZE, true);
+	prime[0] = false;
+	prime[1] = false;
+	for (std::uint32_t i = 2; i * i < SIZE; ++i) {
+		if (prime[i]) {
+			for (std::uint32_t j = i * i; j < SIZE; j += i) {
+				prime[j] = false;
+			}
+		}
+	}
+	return prime;
+}
+// Description:
+// * Returns a sieve of Eratosthenes over the 16-bit range.
+
+
+template <typename Wide, typename Word>
+static bool millerRabin(Word n, const Word* bases, unsigned int baseCount)
+{
+	if (n < 2) {
+		return false;
+	}
+	if (n % 2 == 0) {
+		return n == 2;
+	}
+	Word d = n - 1;
+	unsigned int r = 0;
+	while (d % 2 == 0) {
+		d /= 2;
+		++r;
+	}
+	for (unsigned int b = 0; b < baseCount; ++b) {
+		Word a = bases[b] % n;
+		if (a == 0) {
+			continue;
+		}
+		// x = a^d mod n
+		Word x = 1;
+		for (Word e = d, p = a; e; e /= 2) {
+			if (e % 2) {
+				x = static_cast<Word>(Wide(x) * p % n);
+			}
+			p = static_cast<Word>(Wide(p) * p % n);
+		}
+		if (x == 1 || x == n - 1) {
+			continue;
+		}
+		bool composite = true;
+		for (unsigned int i = 1; i < r && composite; ++i) {
+			x = static_cast<Word>(Wide(x) * x % n);
+			composite = (x != n - 1);
+		}
+		if (composite) {
+			return false;
+		}
+	}
+	return true;
+}
+// Description:
+// * Returns whether "n" is prime, testing the "baseCount" witnesses "bases".
+// Products are taken in "Wide", which must hold the square of a "Word".
+
+
+bool isPrime16(std::uint16_t val)
+{
+	static const std::vector<bool> PRIME = sieve16();
+	return PRIME[val];
+}
+
+
+bool isPrime32(std::uint32_t val)
+{
+	static const std::uint32_t BASES[] = { 2, 7, 61 };
+	return millerRabin<std::uint64_t>(val, BASES, 3);
+}
+
+
+bool isPrime64(std::uint64_t val)
+{
+	static const std::uint64_t BASES[] = { 2, 325, 9375, 28178, 450775,
+										   9780504, 1795265022 };
+	return millerRabin<uint128>(val, BASES, 7);
+}
\ No newline at end of file
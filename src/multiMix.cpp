@@ -5,117 +5,493 @@
 // PLATFORM: GCC v7.1.0
 
 // Implementation Invariant:
-// * numMixers are tracked via a stack.
+// * numMixers are tracked via a stack, stored in a vector (back() is the top).
 // * User decides when numMixers are pushed/removed from stack.
 // * No guards are made against pinging an empty stack.
 // * numMixers rotate through states depending on their index in the stack:
 // [0] Mix -> [1] Even -> [2] Odd -> [3] Mix
-// * Prime numbers are checked against a predefined list < 100.
-// * numMixers must be seeded with a dataset 2-100, else prime numbers can't
-// be checked.
+// * Prime numbers are checked by the value type's mixValueTraits, through
+// mixPipeline::primePurge().
+// * Pings are run through the pipeline of their state before being sorted, so
+// the sort only sees the values kept.
+// * Datasets are taken from, and returned to, "_datasetPool".
+// * "_stackHash" is the sum of slotHash() over the stack. Every push, pop and
+// ping adds/subtracts the affected slots, keeping it up to date.
+// * addNumMixersParallel() seeds chunks of numMixers on worker threads, into
+// per-chunk vectors, then moves them onto the stack in chunk order. Workers
+// never touch "_eng", "_datasetPool" or the stack: pooled buffers are
+// acquired beforehand, and each worker takes those of its own chunks.
+// * Under any policy but STACK, "_schedule" is a heap holding an entry for
+// every scheduled numMixer. Popping or retiring a numMixer zeroes its slot id
+// and leaves its entry behind, which is skipped when it surfaces, or dropped
+// by compactSchedule(). Pinged numMixers are re-keyed at the back of the heap
+// and sifted back in, so a ping costs O(log n) amortized. numMixers with a
+// replenishPolicy that fail a ping are re-keyed the same way, and the ping
+// ends there, so a drained tokenBucket parks them instead of retiring them.
+// * A lazyPings() view makes one ping per block, through the same pingSlot()
+// and pingScheduled() as ping(), so the schedule advances exactly as it would
+// under as many calls to ping(). A failed ping ends the view rather than
+// yielding its values.
 
 
-#include <ctime>  // time
-#include <stack>  // stack
+#include <cstddef>  // size_t
+#include <cstdint>  // int16_t, int64_t, uint32_t, uint64_t
 #include <vector>  // vector
-#include <algorithm>  // binary_search
-#include <random>  // mt19937
+#include <algorithm>  // min, max, push_heap, pop_heap,
+					  // make_heap, remove_if
+#include <atomic>  // atomic
+#include <iterator>  // make_move_iterator
+#include <random>  // mt19937, seed_seq
+#include <thread>  // thread
+#include <utility>  // move
 
 
+#include "../include/datasetPool.h"
+#include "../include/mixKernels.h"
+#include "../include/mixResult.h"
+#include "../include/mixSeed.h"
+#include "../include/mixValue.h"
 #include "../include/multiMix.h"
 #include "../include/numMixer.h"
+#include "../include/packedDataset.h"
+#include "../include/pingView.h"
 
 
-const std::vector<int> multiMix::_PRIME_NUMBERS = { 2, 3, 5, 7, 11,
-													13, 17, 19, 23, 29,
-													31, 37, 41, 43, 47,
-													53, 59, 61, 67, 71,
-													73, 79, 83, 89, 97 };
+template <typename T>
+thread_local std::mt19937 basicMultiMix<T>::_eng = seedThreadEngine();
 
 
-std::mt19937 multiMix::_eng(time(0));
+template <typename T>
+const unsigned int basicMultiMix<T>::_DATASET_SIZE;
 
 
-multiMix::multiMix():
-	_numMixerStack()
+template <typename T>
+const unsigned int basicMultiMix<T>::_CHUNK_SIZE;
+
+
+template <typename T>
+basicMultiMix<T>::basicMultiMix():
+	_numMixerStack(),
+	_datasetPool(),
+	_stackHash(0),
+	_schedulePolicy(STACK),
+	_schedule(),
+	_slotIds(),
+	_nextSlotId(0),
+	_scheduleTick(0),
+	_scheduledCount(0),
+	_packedDatasets(false),
+	_sortedOutput(false),
+	_pipelines(defaultPipelines())
+{
+}
+
+
+template <typename T>
+basicMultiMix<T>::basicMultiMix(basicMultiMix&& obj) noexcept:
+	_numMixerStack(),
+	_datasetPool(),
+	_stackHash(0),
+	_schedulePolicy(STACK),
+	_schedule(),
+	_slotIds(),
+	_nextSlotId(0),
+	_scheduleTick(0),
+	_scheduledCount(0),
+	_packedDatasets(false),
+	_sortedOutput(false),
+	_pipelines()
+{
+	*this = std::move(obj);
+}
+
+
+template <typename T>
+basicMultiMix<T>& basicMultiMix<T>::operator=(basicMultiMix&& obj) noexcept
 {
+	if (this == &obj) {
+		return *this;
+	}
+	_numMixerStack = std::move(obj._numMixerStack);
+	_datasetPool = std::move(obj._datasetPool);
+	_stackHash = obj._stackHash;
+	_schedulePolicy = obj._schedulePolicy;
+	_schedule = std::move(obj._schedule);
+	_slotIds = std::move(obj._slotIds);
+	_nextSlotId = obj._nextSlotId;
+	_scheduleTick = obj._scheduleTick;
+	_scheduledCount = obj._scheduledCount;
+	_packedDatasets = obj._packedDatasets;
+	_sortedOutput = obj._sortedOutput;
+	_pipelines = std::move(obj._pipelines);
+
+	// leave "obj" empty, with a hash and schedule to match, and its pipelines
+	// standing for the defaults
+	obj._numMixerStack.clear();
+	obj._stackHash = 0;
+	obj._schedule.clear();
+	obj._slotIds.clear();
+	obj._scheduledCount = 0;
+	obj._pipelines.clear();
+	return *this;
 }
 
 
-multiMix::~multiMix()
+template <typename T>
+basicMultiMix<T>::~basicMultiMix()
 {
 }
 
 
-std::vector<int> multiMix::ping()
+template <typename T>
+typename basicMultiMix<T>::mixResult basicMultiMix<T>::ping()
 {
-	numMixer& rNumMixerObj = _numMixerStack.top();
 	const int SIZE = 10;
-	std::vector<int> returnset(SIZE);
-	switch (_numMixerStack.size() - 1 % 3) {
-		case 0:
-			rNumMixerObj.setControllerState(numMixer::MIX);
-			rNumMixerObj.ping(returnset);
-			purgePrimeNumbers(returnset);
-			return returnset;
-		case 1:
-			rNumMixerObj.setControllerState(numMixer::EVEN);
-			rNumMixerObj.ping(returnset);
-			return returnset;
-		case 2:
-			rNumMixerObj.setControllerState(numMixer::ODD);
-			rNumMixerObj.ping(returnset);
-			return returnset;
-		default:
-			return std::vector<int> (0);
+	mixResult returnset(SIZE);
+	if (_schedulePolicy == STACK) {
+		pingSlot(_numMixerStack.size() - 1, returnset);
+		return returnset;
 	}
+	if (!pingScheduled(returnset)) {
+		returnset.clear();
+	}
+	return returnset;
 }
 
 
-void multiMix::addNumMixers(unsigned int count)
+template <typename T>
+typename basicMultiMix<T>::pingView basicMultiMix<T>::lazyPings(
+	unsigned int count)
 {
-	std::vector<int> dataset;
-	while (count--) {
-		_numMixerStack.push(numMixer(generateDataset()));
+	unsigned int left = count;
+	return pingView([this, left](std::vector<T>& block) mutable {
+		if (!left || (_schedulePolicy == STACK && _numMixerStack.empty())) {
+			return false;
+		}
+		--left;
+		const int SIZE = 10;
+		mixResult out(SIZE);
+		const bool PINGED = (_schedulePolicy == STACK ?
+							 pingSlot(_numMixerStack.size() - 1, out) :
+							 pingScheduled(out));
+		if (!PINGED) {
+			left = 0;
+			return false;
+		}
+		block.assign(out.begin(), out.end());
+		return true;
+	});
+}
+
+
+template <typename T>
+void basicMultiMix<T>::seed(std::uint32_t seed)
+{
+	_eng.seed(seed);
+}
+
+
+template <typename T>
+void basicMultiMix<T>::setSchedulePolicy(SchedulePolicy policy)
+{
+	_schedulePolicy = policy;
+	_schedule.clear();
+	_scheduledCount = 0;
+	_slotIds.assign(_numMixerStack.size(), 0);
+	if (_schedulePolicy == STACK) {
+		return;
+	}
+	_schedule.reserve(_numMixerStack.size());
+	for (std::size_t i = 0; i < _numMixerStack.size(); ++i) {
+		if (schedulable(_numMixerStack[i])) {
+			schedule(i, _schedulePolicy == ROUND_ROBIN ? ++_scheduleTick : 0);
+		}
+	}
+}
+
+
+template <typename T>
+void basicMultiMix<T>::setPackedDatasets(bool packed)
+{
+	_packedDatasets = packed;
+}
+
+
+template <typename T>
+void basicMultiMix<T>::setSortedOutput(bool sorted)
+{
+	_sortedOutput = sorted;
+}
+
+
+template <typename T>
+void basicMultiMix<T>::setPipeline(typename numMixer::OutputController state,
+								   mixPipeline pipeline)
+{
+	if (_pipelines.empty()) {
+		_pipelines = defaultPipelines();
+	}
+	_pipelines[state] = std::move(pipeline);
+}
+
+
+template <typename T>
+void basicMultiMix<T>::addNumMixers(unsigned int count)
+{
+	std::size_t first = _numMixerStack.size();
+	if (_packedDatasets) {
+		// values are generated into one scratch buffer, then packed
+		std::vector<T> dataset(_DATASET_SIZE);
+		while (count--) {
+			fillDataset(dataset, _eng);
+			_numMixerStack.emplace_back(packedDataset(dataset));
+		}
+	} else {
+		while (count--) {
+			_numMixerStack.emplace_back(generateDataset());
+		}
+	}
+	trackSlots(first);
+}
+
+
+template <typename T>
+void basicMultiMix<T>::addNumMixersParallel(unsigned int count,
+											unsigned int threadCount)
+{
+	const unsigned int SEED = _eng();
+	const unsigned int CHUNK_COUNT = (count + _CHUNK_SIZE - 1) / _CHUNK_SIZE;
+
+	if (threadCount == 0) {
+		threadCount = std::thread::hardware_concurrency();
+	}
+	threadCount = std::max(1u, std::min(threadCount, CHUNK_COUNT));
+
+	// the first numMixers get the pooled buffers, the rest allocate
+	std::vector<std::vector<T> > pooled;
+	if (!_packedDatasets) {
+		pooled.resize(std::min(count, _datasetPool.available()));
+		for (auto& buffer : pooled) {
+			buffer = _datasetPool.acquire(_DATASET_SIZE);
+		}
+	}
+
+	// seed every chunk from its own substream
+	std::vector<std::vector<numMixer> > chunks(CHUNK_COUNT);
+	std::atomic<unsigned int> nextChunk(0);
+	auto worker = [&]() {
+		std::vector<T> dataset;
+		unsigned int chunk;
+		while ((chunk = nextChunk++) < CHUNK_COUNT) {
+			std::seed_seq seq = { SEED, chunk };
+			std::mt19937 eng(seq);
+			std::size_t index = chunk * _CHUNK_SIZE;
+			unsigned int size = std::min(_CHUNK_SIZE,
+										 count - chunk * _CHUNK_SIZE);
+			std::vector<numMixer>& mixers = chunks[chunk];
+			mixers.reserve(size);
+			while (size--) {
+				if (index < pooled.size()) {
+					dataset = std::move(pooled[index]);
+				}
+				++index;
+				dataset.resize(_DATASET_SIZE);
+				fillDataset(dataset, eng);
+				if (_packedDatasets) {
+					mixers.emplace_back(packedDataset(dataset), eng);
+				} else {
+					mixers.emplace_back(std::move(dataset), eng);
+					dataset.clear();
+				}
+			}
+		}
+	};
+	std::vector<std::thread> threads;
+	for (unsigned int i = 1; i < threadCount; ++i) {
+		threads.emplace_back(worker);
+	}
+	worker();
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	// publish
+	std::size_t first = _numMixerStack.size();
+	_numMixerStack.reserve(_numMixerStack.size() + count);
+	for (auto& mixers : chunks) {
+		_numMixerStack.insert(_numMixerStack.end(),
+							  std::make_move_iterator(mixers.begin()),
+							  std::make_move_iterator(mixers.end()));
 	}
+	trackSlots(first);
 }
 
 
-void multiMix::removeNumMixers(unsigned int count)
+template <typename T>
+void basicMultiMix<T>::removeNumMixers(unsigned int count)
 {
 	while (count--) {
-		_numMixerStack.pop();
+		_stackHash -= slotHash(_numMixerStack.size() - 1,
+							   _numMixerStack.back());
+		if (_slotIds.back()) {
+			--_scheduledCount;
+		}
+		_slotIds.pop_back();
+		if (!_numMixerStack.back().isPacked()) {
+			_datasetPool.release(_numMixerStack.back().releaseDataset());
+		}
+		_numMixerStack.pop_back();
 	}
+	compactSchedule();
+}
+
+
+template <typename T>
+void basicMultiMix<T>::reserveNumMixers(unsigned int count)
+{
+	_numMixerStack.reserve(_numMixerStack.size() + count);
+	_slotIds.reserve(_slotIds.size() + count);
+	_datasetPool.reserve(count, _DATASET_SIZE);
+}
+
+
+template <typename T>
+std::vector<T> basicMultiMix<T>::generateDataset(unsigned int size)
+{
+	std::vector<T> dataset = _datasetPool.acquire(size);
+	fillDataset(dataset, _eng);
+	return dataset;
 }
 
 
-std::vector<int> multiMix::generateDataset(unsigned int size)
+template <typename T>
+template <typename Engine>
+void basicMultiMix<T>::fillDataset(std::vector<T>& dataset, Engine& eng)
 {
 	const int LOWER_BOUND = 2;
 	const int UPPER_BOUND = 100;
 	std::uniform_int_distribution<> distr(LOWER_BOUND, UPPER_BOUND);
-	std::vector<int> dataset(size);
 	for (auto& val : dataset) {
-		val = distr(_eng);
+		val = distr(eng);
 	}
-	return dataset;
 }
 
 
-bool multiMix::isPrime(int n)
+template <typename T>
+bool basicMultiMix<T>::pingSlot(std::size_t index, mixResult& returnset)
+{
+	numMixer& rNumMixerObj = _numMixerStack[index];
+	bool pinged = false;
+	_stackHash -= slotHash(index, rNumMixerObj);
+	switch (index % 3) {
+		case 0:
+			rNumMixerObj.setControllerState(numMixer::MIX);
+			break;
+		case 1:
+			rNumMixerObj.setControllerState(numMixer::EVEN);
+			break;
+		case 2:
+			rNumMixerObj.setControllerState(numMixer::ODD);
+			break;
+	}
+	pinged = rNumMixerObj.ping(returnset.data(), returnset.size());
+	if (pinged) {
+		pipeline(rNumMixerObj.getControllerState()).apply(returnset);
+	}
+	if (pinged && _sortedOutput) {
+		sortValues(returnset.data(), returnset.size());
+	}
+	_stackHash += slotHash(index, rNumMixerObj);
+	return pinged;
+}
+
+
+template <typename T>
+bool basicMultiMix<T>::pingScheduled(mixResult& returnset)
+{
+	while (!_schedule.empty()) {
+		std::pop_heap(_schedule.begin(), _schedule.end(), scheduleBefore);
+		scheduleEntry& rEntry = _schedule.back();
+		if (rEntry.index >= _slotIds.size() ||
+			_slotIds[rEntry.index] != rEntry.id) {
+			// popped or retired
+			_schedule.pop_back();
+			continue;
+		}
+		bool pinged = pingSlot(rEntry.index, returnset);
+		if (schedulable(_numMixerStack[rEntry.index])) {
+			// pinged, or parked until its replenishPolicy grants again
+			rEntry.key = scheduleKey(rEntry.index, ++_scheduleTick);
+			std::push_heap(_schedule.begin(), _schedule.end(), scheduleBefore);
+			return pinged;
+		}
+		// retire
+		_slotIds[rEntry.index] = 0;
+		--_scheduledCount;
+		_schedule.pop_back();
+		if (pinged) {
+			return true;
+		}
+	}
+	return false;
+}
+
+
+template <typename T>
+const std::vector<typename basicMultiMix<T>::mixPipeline>&
+basicMultiMix<T>::defaultPipelines()
 {
-	return std::binary_search(_PRIME_NUMBERS.begin(), _PRIME_NUMBERS.end(), n);
+	static const std::vector<mixPipeline> DEFAULTS = []() {
+		std::vector<mixPipeline> pipelines(3);
+		pipelines[numMixer::MIX] = mixPipeline::primePurge();
+		return pipelines;
+	}();
+	return DEFAULTS;
 }
 
 
-void multiMix::purgePrimeNumbers(std::vector<int>& arr)
+template <typename T>
+void basicMultiMix<T>::trackSlots(std::size_t first)
 {
-	int newSize = arr.size();
-	for (int i = arr.size() - 1; i >= 0; --i) {
-		if (isPrime(arr[i])) {
-			arr[i] = arr[newSize - 1];
-			--newSize;
+	for (std::size_t i = first; i < _numMixerStack.size(); ++i) {
+		_stackHash += slotHash(i, _numMixerStack[i]);
+		_slotIds.push_back(0);
+		if (_schedulePolicy != STACK && schedulable(_numMixerStack[i])) {
+			schedule(i, _schedulePolicy == ROUND_ROBIN ? ++_scheduleTick : 0);
 		}
 	}
-	arr.resize(newSize);
-}
\ No newline at end of file
+}
+
+
+template <typename T>
+void basicMultiMix<T>::schedule(std::size_t index, std::uint64_t lastUsed)
+{
+	_slotIds[index] = ++_nextSlotId;
+	++_scheduledCount;
+	scheduleEntry entry = { scheduleKey(index, lastUsed), index, _nextSlotId };
+	_schedule.push_back(entry);
+	std::push_heap(_schedule.begin(), _schedule.end(), scheduleBefore);
+}
+
+
+template <typename T>
+void basicMultiMix<T>::compactSchedule()
+{
+	const std::size_t SLACK = 16;
+	if (_schedule.size() <= 2 * static_cast<std::size_t>(_scheduledCount) +
+							 SLACK) {
+		return;
+	}
+	auto stale = [this](const scheduleEntry& entry) {
+		return (entry.index >= _slotIds.size() ||
+				_slotIds[entry.index] != entry.id);
+	};
+	_schedule.erase(std::remove_if(_schedule.begin(), _schedule.end(), stale),
+					_schedule.end());
+	std::make_heap(_schedule.begin(), _schedule.end(), scheduleBefore);
+}
+
+
+template class basicMultiMix<std::int16_t>;
+template class basicMultiMix<int>;
+template class basicMultiMix<std::int64_t>;
\ No newline at end of file
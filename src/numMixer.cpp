@@ -5,90 +5,224 @@
 // PLATFORM: GCC v7.1.0
 
 
-#include <ctime>  // time
 #include <vector>  // vector
-#include <algorithm>  // copy
+#include <algorithm>  // copy, min
+#include <cstdint>  // int16_t, int64_t, uint32_t
+#include <memory>  // shared_ptr
 #include <random>  // mt19937, uniform_int_distribution
 #include <string>  // string
+#include <utility>  // move
 
 
+#include "../include/mixHash.h"
+#include "../include/mixSeed.h"
 #include "../include/numMixer.h"
+#include "../include/packedDataset.h"
+#include "../include/randomReservoir.h"
+#include "../include/replenishPolicy.h"
 
 
-std::mt19937 numMixer::_eng(time(0));
+template <typename T>
+thread_local std::mt19937 basicNumMixer<T>::_eng = seedThreadEngine();
 
 
-numMixer::numMixer():
-	_evenValid(true),
-	_oddValid(true),
+template <typename T>
+basicNumMixer<T>::basicNumMixer():
+	basicNumMixer(range{ 1, 100, 1 }, _eng)
+{
+}
+
+
+template <typename T>
+basicNumMixer<T>::basicNumMixer(std::vector<T> dataset):
+	basicNumMixer(std::move(dataset), _eng)
+{
+}
+
+
+template <typename T>
+basicNumMixer<T>::basicNumMixer(std::vector<T> dataset, std::mt19937& eng):
 	_stateChangeCount(0),
 	_countDown(0),
-	_dataset(0),
-	_controllerState(MIX)
+	_evenCount(0),
+	_oddCount(0),
+	_dataset(std::move(dataset)),
+	_range(),
+	_packed(),
+	_datasetHash(0),
+	_controllerState(MIX),
+	_replenishPolicy(),
+	_reservoir()
 {
-	// generate valid dataset
-	const int SIZE = 100;
-	_dataset.resize(SIZE);
-	for (int i = 0; i < SIZE; ++i) {
-		_dataset[i] = i + 1;
+	// validate and hash dataset
+	for (auto& val : _dataset) {
+		countValue(val, 1);
 	}
-
+	
 	// calc max ping count
 	const int LOWER_BOUND = 10;
 	const int UPPER_BOUND = 20;
 	std::uniform_int_distribution<> distr(LOWER_BOUND, UPPER_BOUND);
-	_countDown = distr(_eng);
+	_countDown = distr(eng);
 }
 
 
-numMixer::numMixer(std::vector<int> dataset):
-	_evenValid(false),
-	_oddValid(false),
+template <typename T>
+basicNumMixer<T>::basicNumMixer(const range& dataset):
+	basicNumMixer(dataset, _eng)
+{
+}
+
+
+template <typename T>
+basicNumMixer<T>::basicNumMixer(const range& dataset, std::mt19937& eng):
 	_stateChangeCount(0),
 	_countDown(0),
-	_dataset(0),
-	_controllerState(MIX)
+	_evenCount(0),
+	_oddCount(0),
+	_dataset(),
+	_range(dataset),
+	_packed(),
+	_datasetHash(0),
+	_controllerState(MIX),
+	_replenishPolicy(),
+	_reservoir()
 {
-	// copy dataset
-	_dataset = dataset;
+	// count parities in closed form, with an odd stride they alternate
+	// starting from the parity of the start
+	unsigned int startParity = _range.count;
+	if (isOdd(_range.stride)) {
+		startParity = (_range.count + 1) / 2;
+	}
+	if (isOdd(_range.start)) {
+		_oddCount = startParity;
+		_evenCount = _range.count - startParity;
+	} else {
+		_evenCount = startParity;
+		_oddCount = _range.count - startParity;
+	}
 
-	// validate dataset
-	for (auto& val : _dataset) {
-		if (val % 2) {
-			_oddValid = true;
-		} else {
-			_evenValid = true;
-		}
+	// hash dataset
+	for (unsigned int i = 0; i < _range.count; ++i) {
+		_datasetHash += mixValueTraits<T>::hash(rangeValue(i));
 	}
-	
+
+	// calc max ping count
+	const int LOWER_BOUND = 10;
+	const int UPPER_BOUND = 20;
+	std::uniform_int_distribution<> distr(LOWER_BOUND, UPPER_BOUND);
+	_countDown = distr(eng);
+}
+
+
+template <typename T>
+basicNumMixer<T>::basicNumMixer(packedDataset dataset):
+	basicNumMixer(std::move(dataset), _eng)
+{
+}
+
+
+template <typename T>
+basicNumMixer<T>::basicNumMixer(packedDataset dataset, std::mt19937& eng):
+	_stateChangeCount(0),
+	_countDown(0),
+	_evenCount(0),
+	_oddCount(0),
+	_dataset(),
+	_range(),
+	_packed(std::move(dataset)),
+	_datasetHash(0),
+	_controllerState(MIX),
+	_replenishPolicy(),
+	_reservoir()
+{
+	// validate and hash dataset
+	for (unsigned int i = 0; i < _packed.size(); ++i) {
+		countValue(_packed[i], 1);
+	}
+
 	// calc max ping count
 	const int LOWER_BOUND = 10;
 	const int UPPER_BOUND = 20;
 	std::uniform_int_distribution<> distr(LOWER_BOUND, UPPER_BOUND);
-	_countDown = distr(_eng);
+	_countDown = distr(eng);
+}
+
+
+template <typename T>
+basicNumMixer<T>::~basicNumMixer()
+{
+}
+
+
+template <typename T>
+bool basicNumMixer<T>::ping(std::vector<T>& returnValues)
+{
+	return ping(returnValues.data(), returnValues.size());
 }
 
 
-numMixer::~numMixer()
+template <typename T>
+bool basicNumMixer<T>::ping(T* returnValues, unsigned int size)
 {
+	if (!claimPing()) {
+		return false;
+	}
+	drawValues(returnValues, size);
+	return true;
 }
 
 
-bool numMixer::ping(std::vector<int>& returnValues)
+template <typename T>
+typename basicNumMixer<T>::pingView basicNumMixer<T>::lazyPing(
+	unsigned int size)
 {
-	if (isActive() && checkStateValid()) {
-		for (auto& val : returnValues) {
-			val = genRandNum();
+	// the countdown is claimed with the first block, not up front
+	unsigned int left = size;
+	bool claimed = false;
+	return pingView([this, left, claimed](std::vector<T>& block) mutable {
+		if (!left) {
+			return false;
 		}
-		--_countDown;
+		if (!claimed) {
+			if (!claimPing()) {
+				return false;
+			}
+			claimed = true;
+		} else if (!checkStateValid()) {
+			return false;
+		}
+		const unsigned int COUNT = std::min<std::size_t>(
+			left, pingView::blockSize());
+		block.resize(COUNT);
+		drawValues(block.data(), COUNT);
+		left -= COUNT;
 		return true;
-	} else {
-		return false;
+	});
+}
+
+
+template <typename T>
+std::vector<T> basicNumMixer<T>::dataset() const
+{
+	if (!_packed.empty()) {
+		std::vector<T> dataset(_packed.size());
+		_packed.unpack(dataset.data());
+		return dataset;
 	}
+	if (!_range.count) {
+		return _dataset;
+	}
+	std::vector<T> dataset(_range.count);
+	for (unsigned int i = 0; i < _range.count; ++i) {
+		dataset[i] = rangeValue(i);
+	}
+	return dataset;
 }
 
 
-std::string numMixer::getControllerStateName() const
+template <typename T>
+std::string basicNumMixer<T>::getControllerStateName() const
 {
 	switch (_controllerState) {
 		case MIX:
@@ -103,7 +237,8 @@ std::string numMixer::getControllerStateName() const
 }
 
 
-void numMixer::setControllerState(OutputController state)
+template <typename T>
+void basicNumMixer<T>::setControllerState(OutputController state)
 {
 	if (getControllerState() != state) {
 		_controllerState = state;
@@ -112,41 +247,233 @@ void numMixer::setControllerState(OutputController state)
 }
 
 
-int numMixer::genRandNum()
+template <typename T>
+void basicNumMixer<T>::setReplenishPolicy(
+		std::shared_ptr<replenishPolicy> policy)
 {
-	int upperBound = _dataset.size() - 1;
+	_replenishPolicy = std::move(policy);
+}
+
+
+template <typename T>
+void basicNumMixer<T>::seed(std::uint32_t seed)
+{
+	_eng.seed(seed);
+}
+
+
+template <typename T>
+bool basicNumMixer<T>::pack()
+{
+	if (_dataset.empty() || !packedDataset::packable(_dataset)) {
+		return isPacked();
+	}
+	_packed = packedDataset(_dataset);
+	std::vector<T>().swap(_dataset);
+	return true;
+}
+
+
+template <typename T>
+void basicNumMixer<T>::setReservoir(
+		std::shared_ptr<randomReservoir> reservoir)
+{
+	_reservoir = std::move(reservoir);
+}
+
+
+template <typename T>
+template <typename Engine>
+T basicNumMixer<T>::genRandNum(Engine& eng)
+{
+	if (_range.count) {
+		return genRangeNum(eng);
+	}
+	if (!_packed.empty()) {
+		return pickValue(_packed, _packed.size(), eng);
+	}
+	return pickValue(_dataset.data(), _dataset.size(), eng);
+}
+
+
+template <typename T>
+template <typename Engine>
+void basicNumMixer<T>::genRandNums(T* returnValues,
+								   unsigned int size,
+								   Engine& eng)
+{
+	if (!_packed.empty() && size >= _packed.size()) {
+		// unpack once rather than decoding every draw
+		static thread_local std::vector<T> unpacked;
+		unpacked.resize(_packed.size());
+		_packed.unpack(unpacked.data());
+		for (unsigned int i = 0; i < size; ++i) {
+			returnValues[i] = pickValue(unpacked.data(), unpacked.size(), eng);
+		}
+		return;
+	}
+	for (unsigned int i = 0; i < size; ++i) {
+		returnValues[i] = genRandNum(eng);
+	}
+}
+
+
+template <typename T>
+template <typename Engine, typename Values>
+T basicNumMixer<T>::pickValue(const Values& values,
+							  unsigned int count,
+							  Engine& eng)
+{
+	int upperBound = count - 1;
 	std::uniform_int_distribution<> distr(0, upperBound);
-	int i = distr(_eng);
+	int i = distr(eng);
 
 	switch (_controllerState) {
 		case MIX:
-			return _dataset[i];
+			return values[i];
 		case EVEN:
-			while (_dataset[i] % 2 != 0) {
-				i = distr(_eng);
+			while (isOdd(values[i])) {
+				i = distr(eng);
 			}
-			return _dataset[i];
+			return values[i];
 		case ODD:
-			while (_dataset[i] % 2 != 1) {
-				i = distr(_eng);
+			while (!isOdd(values[i])) {
+				i = distr(eng);
 			}
-			return _dataset[i];
+			return values[i];
 		default:
 			return 0;
 	}
 }
 
 
-bool numMixer::checkStateValid() const
+template <typename T>
+template <typename Engine>
+T basicNumMixer<T>::genRangeNum(Engine& eng)
+{
+	// with an odd stride, the values of the start's parity sit at the even
+	// indexes and the others at the odd indexes, an even stride keeps the
+	// parity of the start throughout
+	unsigned int first = 0;
+	unsigned int step = 1;
+	unsigned int count = _range.count;
+	if (_controllerState != MIX && isOdd(_range.stride)) {
+		bool startMatches = (isOdd(_range.start) == (_controllerState == ODD));
+		first = startMatches ? 0 : 1;
+		step = 2;
+		count = startMatches ? (count + 1) / 2 : count / 2;
+	}
+	std::uniform_int_distribution<> distr(0, count - 1);
+	return rangeValue(first + step * distr(eng));
+}
+
+
+template <typename T>
+void basicNumMixer<T>::materialize()
+{
+	if (!_packed.empty()) {
+		_dataset.resize(_packed.size());
+		_packed.unpack(_dataset.data());
+		_packed = packedDataset();
+		return;
+	}
+	if (!_range.count) {
+		return;
+	}
+	_dataset.resize(_range.count);
+	for (unsigned int i = 0; i < _range.count; ++i) {
+		_dataset[i] = rangeValue(i);
+	}
+	_range = range();
+}
+
+
+template <typename T>
+bool basicNumMixer<T>::equalDataset(const basicNumMixer& obj) const
+{
+	if (!_packed.empty() && !obj._packed.empty()) {
+		return (_datasetHash == obj._datasetHash && _packed == obj._packed);
+	}
+	if (!_range.count && !obj._range.count &&
+		_packed.empty() && obj._packed.empty()) {
+		return (_datasetHash == obj._datasetHash && _dataset == obj._dataset);
+	}
+	if (_range.count && obj._range.count) {
+		return (_range.start == obj._range.start &&
+				_range.count == obj._range.count &&
+				(_range.count == 1 || _range.stride == obj._range.stride));
+	}
+	if (datasetSize() != obj.datasetSize()) {
+		return false;
+	}
+	for (unsigned int i = 0; i < datasetSize(); ++i) {
+		if (datasetValue(i) != obj.datasetValue(i)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+
+template <typename T>
+bool basicNumMixer<T>::continuesRange(const basicNumMixer& obj) const
+{
+	return (_range.count && obj._range.count &&
+			_range.stride == obj._range.stride &&
+			obj._range.start == rangeValue(_range.count));
+}
+
+
+template <typename T>
+bool basicNumMixer<T>::checkStateValid() const
 {
 	switch (_controllerState) {
 		case MIX:
-			return true;
+			return (datasetSize() > 0);
 		case EVEN:
-			return _evenValid;
+			return (_evenCount > 0);
 		case ODD:
-			return _oddValid;
+			return (_oddCount > 0);
 		default:
 			return false;
 	}
-}
\ No newline at end of file
+}
+
+
+template <typename T>
+bool basicNumMixer<T>::claimPing()
+{
+	if (!isActive()) {
+		replenish();
+	}
+	if (!isActive() || !checkStateValid()) {
+		return false;
+	}
+	--_countDown;
+	return true;
+}
+
+
+template <typename T>
+void basicNumMixer<T>::drawValues(T* returnValues, unsigned int size)
+{
+	if (_reservoir) {
+		genRandNums(returnValues, size, *_reservoir);
+	} else {
+		genRandNums(returnValues, size, _eng);
+	}
+}
+
+
+template <typename T>
+void basicNumMixer<T>::replenish()
+{
+	if (_replenishPolicy) {
+		_countDown += _replenishPolicy->replenish();
+	}
+}
+
+
+template class basicNumMixer<std::int16_t>;
+template class basicNumMixer<int>;
+template class basicNumMixer<std::int64_t>;
\ No newline at end of file
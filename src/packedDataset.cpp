@@ -0,0 +1,109 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: packedDataset.cpp
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Implementation Invariant:
+// * Bits past the last field are left 0, so equal values always pack to
+// equal words.
+// * Offsets are taken in 64-bit unsigned arithmetic, which holds the span of
+// any value type up to 64 bits.
+// * The base is stored as its 64-bit unsigned image, and converted back to T
+// on the way out.
+
+
+#include <algorithm>  // minmax_element, copy
+#include <cstddef>  // size_t
+#include <cstdint>  // int16_t, int64_t, uint32_t, uint64_t
+#include <memory>  // unique_ptr
+#include <utility>  // move
+#include <vector>  // vector
+
+
+#include "../include/packedDataset.h"
+
+
+template <typename T>
+basicPackedDataset<T>::basicPackedDataset():
+	_block()
+{
+}
+
+
+template <typename T>
+basicPackedDataset<T>::basicPackedDataset(const std::vector<T>& values):
+	_block()
+{
+	auto bounds = std::minmax_element(values.begin(), values.end());
+	const std::uint64_t BASE = static_cast<std::uint64_t>(*bounds.first);
+	const std::uint64_t SPAN = static_cast<std::uint64_t>(*bounds.second) -
+							   BASE;
+	unsigned int bitWidth = 0;
+	while (bitWidth < 32 && (SPAN >> bitWidth)) {
+		++bitWidth;
+	}
+
+	// header, then the fields, plus a spare word so readers never run off
+	// the end
+	const std::uint64_t SIZE = static_cast<std::uint32_t>(values.size());
+	const std::uint64_t BITS = SIZE * bitWidth;
+	const std::size_t COUNT = _HEADER + (BITS + 63) / 64 + 1;
+	_block.reset(new std::uint64_t[COUNT]());
+	_block[0] = SIZE | (static_cast<std::uint64_t>(bitWidth) << 32);
+	_block[1] = BASE;
+	std::uint64_t* words = _block.get() + _HEADER;
+	for (unsigned int i = 0; i < SIZE; ++i) {
+		const std::uint64_t OFFSET = static_cast<std::uint64_t>(values[i]) -
+									 BASE;
+		const std::uint64_t BIT = static_cast<std::uint64_t>(i) * bitWidth;
+		const unsigned int SHIFT = BIT % 64;
+		words[BIT / 64] |= OFFSET << SHIFT;
+		if (SHIFT + bitWidth > 64) {
+			words[BIT / 64 + 1] |= OFFSET >> (64 - SHIFT);
+		}
+	}
+}
+
+
+template <typename T>
+basicPackedDataset<T>::basicPackedDataset(const basicPackedDataset& obj):
+	_block()
+{
+	*this = obj;
+}
+
+
+template <typename T>
+basicPackedDataset<T>& basicPackedDataset<T>::operator=(
+	const basicPackedDataset& obj)
+{
+	if (this != &obj) {
+		const std::size_t COUNT = obj.wordCount();
+		std::unique_ptr<std::uint64_t[]> block;
+		if (COUNT) {
+			block.reset(new std::uint64_t[COUNT]);
+			std::copy(obj._block.get(), obj._block.get() + COUNT, block.get());
+		}
+		_block = std::move(block);
+	}
+	return *this;
+}
+
+
+template <typename T>
+bool basicPackedDataset<T>::packable(const std::vector<T>& values)
+{
+	if (values.empty()) {
+		return false;
+	}
+	auto bounds = std::minmax_element(values.begin(), values.end());
+	const std::uint64_t SPAN = static_cast<std::uint64_t>(*bounds.second) -
+							   static_cast<std::uint64_t>(*bounds.first);
+	return (SPAN >> 32) == 0;
+}
+
+
+template class basicPackedDataset<std::int16_t>;
+template class basicPackedDataset<int>;
+template class basicPackedDataset<std::int64_t>;
\ No newline at end of file
@@ -0,0 +1,94 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: pingView.cpp
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Implementation Invariant:
+// * "_block" is refilled in place, so its capacity is reused from block to
+// block, and a view allocates its buffer once.
+// * The read position is at the end of "_block" exactly when no value is
+// buffered. Reads check it first, and only call out to the producer then.
+// * The producer is dropped as soon as it reports the end, releasing the
+// state it holds.
+
+
+#include <algorithm>  // copy, min
+#include <cstddef>  // size_t
+#include <cstdint>  // int16_t, int64_t
+#include <utility>  // move
+#include <vector>  // vector
+
+
+#include "../include/pingView.h"
+
+
+template <typename T>
+const std::size_t basicPingView<T>::_BLOCK;
+
+
+template <typename T>
+basicPingView<T>::basicPingView():
+	_producer(),
+	_block(),
+	_pos(0)
+{
+}
+
+
+template <typename T>
+basicPingView<T>::basicPingView(Producer producer):
+	_producer(std::move(producer)),
+	_block(),
+	_pos(0)
+{
+}
+
+
+template <typename T>
+std::size_t basicPingView<T>::read(T* out, std::size_t count)
+{
+	std::size_t stored = 0;
+	while (stored < count && fill()) {
+		const std::size_t TAKEN = std::min(count - stored,
+										   _block.size() - _pos);
+		std::copy(_block.begin() + _pos, _block.begin() + _pos + TAKEN,
+				  out + stored);
+		_pos += TAKEN;
+		stored += TAKEN;
+	}
+	return stored;
+}
+
+
+template <typename T>
+std::vector<T> basicPingView<T>::collect()
+{
+	std::vector<T> values;
+	while (fill()) {
+		values.insert(values.end(), _block.begin() + _pos, _block.end());
+		_pos = _block.size();
+	}
+	return values;
+}
+
+
+template <typename T>
+bool basicPingView<T>::refill()
+{
+	_block.clear();
+	_pos = 0;
+	while (_block.empty()) {
+		if (!_producer(_block)) {
+			_producer = Producer();
+			_block.clear();
+			return false;
+		}
+	}
+	return true;
+}
+
+
+template class basicPingView<std::int16_t>;
+template class basicPingView<int>;
+template class basicPingView<std::int64_t>;
\ No newline at end of file
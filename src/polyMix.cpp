@@ -0,0 +1,102 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: polyMix.cpp
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Implementation Invariant:
+// * Pings check the plan against the sources first, so a mismatched plan
+// never indexes past either.
+// * "_pulled" is sized to the plan's pull buffer, and every source pings
+// straight into its slice of it.
+// * The output is gathered from "_pulled" through the plan in a single loop.
+// * Duplicates are removed by mixPipeline::duplicatePurge(), keeping the first
+// occurrence of every value.
+
+
+#include <cstddef>  // size_t
+#include <cstdint>  // uint64_t
+#include <algorithm>  // fill
+#include <utility>  // move
+#include <vector>  // vector
+
+
+#include "../include/mixHash.h"
+#include "../include/mixPipeline.h"
+#include "../include/mixPlan.h"
+#include "../include/numMixer.h"
+#include "../include/polyMix.h"
+
+
+polyMix::polyMix():
+	_plan(),
+	_sources(),
+	_pulled()
+{
+}
+
+
+polyMix::polyMix(std::vector<numMixer> sources, mixPlan plan):
+	_plan(std::move(plan)),
+	_sources(std::move(sources)),
+	_pulled()
+{
+}
+
+
+polyMix::~polyMix()
+{
+}
+
+
+std::vector<int> polyMix::ping()
+{
+	if (_plan.sourceCount() != _sources.size()) {
+		return std::vector<int>();
+	}
+
+	// one batched pull per source
+	_pulled.resize(_plan.pullTotal());
+	for (unsigned int s = 0; s < _sources.size(); ++s) {
+		int* pulled = _pulled.data() + _plan.pullOffset(s);
+		const unsigned int COUNT = _plan.pullCount(s);
+		if (!_sources[s].ping(pulled, COUNT)) {
+			std::fill(pulled, pulled + COUNT, 0);
+		}
+	}
+
+	// one plan-driven gather
+	const std::vector<unsigned int>& gather = _plan.gather();
+	std::vector<int> returnset(gather.size());
+	for (std::size_t k = 0; k < gather.size(); ++k) {
+		returnset[k] = _pulled[gather[k]];
+	}
+
+	if (_plan.dedup()) {
+		static const mixPipeline DEDUP = mixPipeline::duplicatePurge();
+		returnset.resize(DEDUP.apply(returnset.data(), returnset.size()));
+	}
+	return returnset;
+}
+
+
+std::size_t polyMix::hash() const
+{
+	std::uint64_t h = _plan.pullTotal();
+	for (const auto& source : _sources) {
+		h = hashCombine(h, source.hash());
+	}
+	return h;
+}
+
+
+void polyMix::addSource(numMixer source)
+{
+	_sources.push_back(std::move(source));
+}
+
+
+void polyMix::setPlan(mixPlan plan)
+{
+	_plan = std::move(plan);
+}
@@ -0,0 +1,115 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: randomReservoir.cpp
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Implementation Invariant:
+// * "_spareReady" hands "_spare" back and forth: the consumer only touches
+// "_spare" while it is set, refillers only while it is clear.
+// * Refillers fill "_spare" under "_engMutex", and re-check "_spareReady"
+// after locking, so refill() and the refill thread never fill it twice.
+// * The consumer only locks "_engMutex" on a block change: briefly after
+// taking the spare block, so the refill thread can not miss the wakeup, and
+// on a miss. A miss re-checks "_spareReady" once locked, and takes the spare
+// block if a refill finished it meanwhile, only refilling on the spot if not.
+
+
+#include <chrono>  // steady_clock, duration_cast
+#include <cstddef>  // size_t
+#include <mutex>  // mutex, lock_guard, unique_lock
+#include <thread>  // thread
+#include <vector>  // vector
+
+
+#include "../include/mixSeed.h"
+#include "../include/randomReservoir.h"
+
+
+randomReservoir::randomReservoir(std::size_t blockSize):
+	_active(blockSize),
+	_next(0),
+	_spare(blockSize),
+	_spareReady(false),
+	_eng(seedThreadEngine()),
+	_engMutex(),
+	_spareTaken(),
+	_stopping(false),
+	_refillThread(),
+	_blocks(0),
+	_misses(0),
+	_refills(0),
+	_refillNanoseconds(0)
+{
+	std::lock_guard<std::mutex> lock(_engMutex);
+	fill(_active);
+	fill(_spare);
+	_spareReady = true;
+}
+
+
+randomReservoir::~randomReservoir()
+{
+	stopBackgroundRefill();
+}
+
+
+void randomReservoir::refill()
+{
+	std::lock_guard<std::mutex> lock(_engMutex);
+	if (!_spareReady.load(std::memory_order_acquire)) {
+		fill(_spare);
+		_spareReady.store(true, std::memory_order_release);
+	}
+}
+
+
+void randomReservoir::startBackgroundRefill()
+{
+	if (!_refillThread.joinable()) {
+		_stopping = false;
+		_refillThread = std::thread(&randomReservoir::backgroundRefill, this);
+	}
+}
+
+
+void randomReservoir::stopBackgroundRefill()
+{
+	if (_refillThread.joinable()) {
+		{
+			std::lock_guard<std::mutex> lock(_engMutex);
+			_stopping = true;
+		}
+		_spareTaken.notify_one();
+		_refillThread.join();
+	}
+}
+
+
+void randomReservoir::fill(std::vector<result_type>& block)
+{
+	auto start = std::chrono::steady_clock::now();
+	for (auto& val : block) {
+		val = _eng();
+	}
+	auto stop = std::chrono::steady_clock::now();
+	++_refills;
+	_refillNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(
+			stop - start).count();
+}
+
+
+void randomReservoir::backgroundRefill()
+{
+	std::unique_lock<std::mutex> lock(_engMutex);
+	for (;;) {
+		_spareTaken.wait(lock, [this]() {
+			return _stopping || !_spareReady.load(std::memory_order_acquire);
+		});
+		if (_stopping) {
+			return;
+		}
+		fill(_spare);
+		_spareReady.store(true, std::memory_order_release);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: replenishPolicy.cpp
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Implementation Invariant:
+// * tokenBucket refills lazily: tokens are only brought up to date when the
+// bucket is read or drawn from, under "_mutex".
+// * sharedBudget draws with a compare-exchange loop, so "_remaining" never
+// goes below 0.
+
+
+#include <algorithm>  // min
+#include <chrono>  // steady_clock, duration
+#include <mutex>  // mutex, lock_guard
+
+
+#include "../include/replenishPolicy.h"
+
+
+replenishPolicy::~replenishPolicy()
+{
+}
+
+
+tokenBucket::tokenBucket(int capacity, double rate, int grant):
+	_capacity(capacity),
+	_rate(rate),
+	_grant(grant),
+	_tokens(capacity),
+	_lastRefill(std::chrono::steady_clock::now()),
+	_mutex()
+{
+}
+
+
+int tokenBucket::replenish()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	refill();
+	int granted = static_cast<int>(std::min(static_cast<double>(_grant),
+											_tokens));
+	_tokens -= granted;
+	return granted;
+}
+
+
+double tokenBucket::tokens()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	refill();
+	return _tokens;
+}
+
+
+void tokenBucket::refill()
+{
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	std::chrono::duration<double> elapsed = now - _lastRefill;
+	_tokens = std::min(_capacity, _tokens + elapsed.count() * _rate);
+	_lastRefill = now;
+}
+
+
+sharedBudget::sharedBudget(long long budget, int grant):
+	_grant(grant),
+	_remaining(budget)
+{
+}
+
+
+int sharedBudget::replenish()
+{
+	long long remaining = _remaining.load();
+	long long granted;
+	do {
+		granted = std::min(static_cast<long long>(_grant), remaining);
+		if (granted <= 0) {
+			return 0;
+		}
+	} while (!_remaining.compare_exchange_weak(remaining,
+											   remaining - granted));
+	return granted;
+}
\ No newline at end of file
@@ -0,0 +1,205 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: shardedMix.cpp
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Implementation Invariant:
+// * "drained" is only written under the shard's lock, and is read without it
+// only as a hint to skip the shard. The shard's schedule decides.
+// * A thread never holds two shard locks at once.
+// * Under STACK a multiMix schedules nothing, so every shard would look
+// drained from the start. The constructors replace it with COUNTDOWN.
+// * Placed shards are only ever seeded on a thread pinned to their cpu, so
+// their datasets are first touched on the cpu's node. addNumMixers() seeds on
+// a fresh thread, so the caller's own affinity is left alone.
+
+
+#include <algorithm>  // max
+#include <atomic>  // atomic
+#include <memory>  // unique_ptr
+#include <mutex>  // mutex, lock_guard
+#include <thread>  // thread, hardware_concurrency
+#include <vector>  // vector
+
+
+#include "../include/mixResult.h"
+#include "../include/mixTopology.h"
+#include "../include/multiMix.h"
+#include "../include/shardedMix.h"
+
+
+shardedMix::shardedMix(unsigned int shardCount,
+					   multiMix::SchedulePolicy policy):
+	_schedulePolicy(policy == multiMix::STACK ? multiMix::COUNTDOWN : policy),
+	_placed(false)
+{
+	if (shardCount == 0) {
+		shardCount = std::max(1u, std::thread::hardware_concurrency());
+	}
+	createShards(shardCount);
+}
+
+
+shardedMix::shardedMix(const mixTopology& topology,
+					   multiMix::SchedulePolicy policy):
+	_schedulePolicy(policy == multiMix::STACK ? multiMix::COUNTDOWN : policy),
+	_topology(topology),
+	_placed(true)
+{
+	createShards(_topology.cpuCount());
+}
+
+
+mixResult shardedMix::ping()
+{
+	const unsigned int HOME = homeShard();
+	for (unsigned int i = 0; i < _shards.size(); ++i) {
+		shard& rShard = *_shards[(HOME + i) % _shards.size()];
+		if (rShard.drained.load(std::memory_order_relaxed)) {
+			continue;
+		}
+		std::lock_guard<std::mutex> guard(rShard.lock);
+		if (rShard.mix.getScheduledCount() == 0) {
+			rShard.drained = true;
+			continue;
+		}
+		mixResult returnset = rShard.mix.ping();
+		if (rShard.mix.getScheduledCount() == 0) {
+			rShard.drained = true;
+		}
+		if (returnset.empty()) {
+			// every numMixer failed and was retired, or those left wait on
+			// their replenishPolicy
+			continue;
+		}
+		++rShard.pings;
+		if (i != 0) {
+			++rShard.steals;
+		}
+		return returnset;
+	}
+	return mixResult();
+}
+
+
+bool shardedMix::pinThread() const
+{
+	if (!_placed) {
+		return false;
+	}
+	return mixTopology::pinThreadToCpu(_topology.cpu(homeShard()));
+}
+
+
+shardedMix::shardStats shardedMix::getShardStats(unsigned int shard) const
+{
+	const struct shard& rShard = *_shards[shard];
+	std::lock_guard<std::mutex> guard(rShard.lock);
+	shardStats stats = { rShard.pings,
+						 rShard.steals,
+						 rShard.mix.getNumMixerCount(),
+						 rShard.mix.getScheduledCount() };
+	return stats;
+}
+
+
+shardedMix::shardStats shardedMix::getStats() const
+{
+	shardStats total = { 0, 0, 0, 0 };
+	for (unsigned int i = 0; i < _shards.size(); ++i) {
+		shardStats stats = getShardStats(i);
+		total.pings += stats.pings;
+		total.steals += stats.steals;
+		total.numMixers += stats.numMixers;
+		total.scheduled += stats.scheduled;
+	}
+	return total;
+}
+
+
+int shardedMix::getNumMixerCount() const
+{
+	return getStats().numMixers;
+}
+
+
+int shardedMix::getScheduledCount() const
+{
+	return getStats().scheduled;
+}
+
+
+void shardedMix::addNumMixers(unsigned int count)
+{
+	for (unsigned int i = 0; i < _shards.size(); ++i) {
+		unsigned int size = share(i, count);
+		if (size == 0) {
+			continue;
+		}
+		if (_placed) {
+			std::thread worker(&shardedMix::seedShard, this, i, size);
+			worker.join();
+		} else {
+			seedShard(i, size);
+		}
+	}
+}
+
+
+void shardedMix::addNumMixersParallel(unsigned int count)
+{
+	std::vector<std::thread> threads;
+	threads.reserve(_shards.size());
+	for (unsigned int i = 0; i < _shards.size(); ++i) {
+		unsigned int size = share(i, count);
+		if (size != 0) {
+			threads.emplace_back(&shardedMix::seedShard, this, i, size);
+		}
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+}
+
+
+unsigned int shardedMix::threadIndex()
+{
+	static std::atomic<unsigned int> nextIndex(0);
+	static thread_local unsigned int index = nextIndex++;
+	return index;
+}
+
+
+unsigned int shardedMix::share(unsigned int shard, unsigned int count) const
+{
+	const unsigned long long SHARDS = _shards.size();
+	return (count * (shard + 1ull) / SHARDS -
+			count * (shard + 0ull) / SHARDS);
+}
+
+
+void shardedMix::seedShard(unsigned int shard, unsigned int count)
+{
+	if (_placed) {
+		mixTopology::pinThreadToCpu(_topology.cpu(shard));
+	}
+	struct shard& rShard = *_shards[shard];
+	std::lock_guard<std::mutex> guard(rShard.lock);
+	rShard.mix.addNumMixers(count);
+	rShard.drained = rShard.mix.getScheduledCount() == 0;
+}
+
+
+void shardedMix::createShards(unsigned int shardCount)
+{
+	_shards.reserve(shardCount);
+	for (unsigned int i = 0; i < shardCount; ++i) {
+		_shards.emplace_back(new shard());
+		shard& rShard = *_shards.back();
+		rShard.mix.setSchedulePolicy(_schedulePolicy);
+		rShard.pings = 0;
+		rShard.steals = 0;
+		rShard.drained = true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,372 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: sharedMix.cpp
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Implementation Invariant:
+// * A segment is laid out as the header, the records right after it, then
+// the values at "valuesOffset", aligned to a cache line. ftruncate() zero
+// fills the segment, so "ready" reads 0 until create() sets it.
+// * create() writes the whole segment before setting "ready" (release), and
+// attach() checks "ready" (acquire) before reading anything else, so an
+// attached process always sees the finished segment.
+// * The header and records are constructed in place in the mapping, which is
+// how their atomics come to life. They are never destroyed, the segment is
+// only ever unmapped.
+// * Every thread keeps its own rng. A fork handler counts forks, and a thread
+// whose rng was seeded before the latest fork reseeds it, so the child draws
+// a stream of its own.
+
+
+#include <atomic>  // atomic, memory_order
+#include <cstddef>  // size_t
+#include <cstdint>  // int16_t, int32_t, int64_t, uint32_t, uint64_t
+#include <new>  // placement new
+#include <random>  // mt19937, uniform_int_distribution
+#include <string>  // string
+#include <utility>  // move, swap
+#include <vector>  // vector
+
+
+#if defined(__unix__)
+#include <fcntl.h>  // O_CREAT, O_EXCL, O_RDWR
+#include <pthread.h>  // pthread_atfork
+#include <sys/mman.h>  // shm_open, shm_unlink, mmap, munmap
+#include <sys/stat.h>  // fstat
+#include <unistd.h>  // ftruncate, close
+#define SHARED_MIX_POSIX
+#endif
+
+
+#include "../include/mixPipeline.h"
+#include "../include/mixResult.h"
+#include "../include/mixSeed.h"
+#include "../include/mixValue.h"
+#include "../include/multiMix.h"
+#include "../include/numMixer.h"
+#include "../include/sharedMix.h"
+
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2,
+			  "shared countdowns need address-free (lock-free) atomics");
+
+
+static std::atomic<unsigned int> forkCount(0);
+
+
+static void countFork()
+{
+	forkCount.fetch_add(1, std::memory_order_relaxed);
+}
+// Description:
+// * Runs in the child after a fork, so rngs seeded before it get reseeded.
+
+
+static std::mt19937& processEngine()
+{
+#if defined(SHARED_MIX_POSIX)
+	static const int REGISTERED = pthread_atfork(0, 0, countFork);
+	(void)REGISTERED;
+#endif
+	static thread_local unsigned int forks =
+		forkCount.load(std::memory_order_relaxed);
+	static thread_local std::mt19937 eng = seedThreadEngine();
+	const unsigned int FORKS = forkCount.load(std::memory_order_relaxed);
+	if (forks != FORKS) {
+		forks = FORKS;
+		eng = seedThreadEngine();
+	}
+	return eng;
+}
+// Description:
+// * Returns the rng of the calling thread, reseeded if the process has forked
+// since it was seeded.
+
+
+template <typename T>
+basicSharedMix<T>::basicSharedMix():
+	_name(),
+	_segment(0),
+	_bytes(0)
+{
+}
+
+
+template <typename T>
+basicSharedMix<T>::basicSharedMix(const std::string& name, void* segment,
+								  std::size_t bytes):
+	_name(name),
+	_segment(segment),
+	_bytes(bytes)
+{
+}
+
+
+template <typename T>
+basicSharedMix<T> basicSharedMix<T>::create(const std::string& name,
+											 const multiMix& source)
+{
+#if defined(SHARED_MIX_POSIX)
+	const std::vector<numMixer>& stack = source.numMixerStack();
+	std::uint64_t valueCount = 0;
+	for (const numMixer& rNumMixerObj : stack) {
+		valueCount += rNumMixerObj.datasetSize();
+	}
+	const std::size_t LINE = 64;
+	const std::size_t RECORDS_END = sizeof(segmentHeader) +
+									stack.size() * sizeof(mixerRecord);
+	const std::size_t VALUES_OFFSET = (RECORDS_END + LINE - 1) / LINE * LINE;
+	const std::size_t BYTES = VALUES_OFFSET + valueCount * sizeof(T);
+
+	int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+	if (fd < 0) {
+		return basicSharedMix();
+	}
+	if (ftruncate(fd, BYTES) != 0) {
+		close(fd);
+		shm_unlink(name.c_str());
+		return basicSharedMix();
+	}
+	void* segment = mmap(0, BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (segment == MAP_FAILED) {
+		shm_unlink(name.c_str());
+		return basicSharedMix();
+	}
+
+	basicSharedMix shared(name, segment, BYTES);
+	segmentHeader* pHeader = new (segment) segmentHeader();
+	pHeader->valueSize = sizeof(T);
+	pHeader->mixerCount = stack.size();
+	pHeader->magic = _MAGIC;
+	pHeader->bytes = BYTES;
+	pHeader->valuesOffset = VALUES_OFFSET;
+	pHeader->activeCount.store(stack.size(), std::memory_order_relaxed);
+
+	T* pValues = reinterpret_cast<T*>(static_cast<char*>(segment) +
+									  VALUES_OFFSET);
+	std::uint64_t offset = 0;
+	for (std::size_t i = 0; i < stack.size(); ++i) {
+		const numMixer& rNumMixerObj = stack[i];
+		mixerRecord* pRecord = new (shared.records() + i) mixerRecord();
+		pRecord->datasetOffset = offset;
+		pRecord->datasetSize = rNumMixerObj.datasetSize();
+		pRecord->evenCount = rNumMixerObj.evenCount();
+		pRecord->oddCount = rNumMixerObj.oddCount();
+		pRecord->countDown.store(rNumMixerObj.countDown(),
+								 std::memory_order_relaxed);
+		for (unsigned int j = 0; j < pRecord->datasetSize; ++j) {
+			pValues[offset + j] = rNumMixerObj.datasetValue(j);
+		}
+		offset += pRecord->datasetSize;
+	}
+	pHeader->ready.store(1, std::memory_order_release);
+	return shared;
+#else
+	(void)name;
+	(void)source;
+	return basicSharedMix();
+#endif
+}
+
+
+template <typename T>
+basicSharedMix<T> basicSharedMix<T>::attach(const std::string& name)
+{
+#if defined(SHARED_MIX_POSIX)
+	int fd = shm_open(name.c_str(), O_RDWR, 0);
+	if (fd < 0) {
+		return basicSharedMix();
+	}
+	struct stat status;
+	if (fstat(fd, &status) != 0 ||
+		static_cast<std::size_t>(status.st_size) < sizeof(segmentHeader)) {
+		close(fd);
+		return basicSharedMix();
+	}
+	const std::size_t BYTES = status.st_size;
+	void* segment = mmap(0, BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (segment == MAP_FAILED) {
+		return basicSharedMix();
+	}
+
+	basicSharedMix shared(name, segment, BYTES);
+	const segmentHeader* pHeader = shared.header();
+	if (pHeader->ready.load(std::memory_order_acquire) != 1 ||
+		pHeader->magic != _MAGIC ||
+		pHeader->valueSize != sizeof(T) ||
+		pHeader->bytes != BYTES) {
+		return basicSharedMix();
+	}
+	return shared;
+#else
+	(void)name;
+	return basicSharedMix();
+#endif
+}
+
+
+template <typename T>
+basicSharedMix<T>::basicSharedMix(basicSharedMix&& obj):
+	_name(),
+	_segment(0),
+	_bytes(0)
+{
+	*this = std::move(obj);
+}
+
+
+template <typename T>
+basicSharedMix<T>& basicSharedMix<T>::operator=(basicSharedMix&& obj)
+{
+	if (this != &obj) {
+		detach();
+		std::swap(_name, obj._name);
+		std::swap(_segment, obj._segment);
+		std::swap(_bytes, obj._bytes);
+	}
+	return *this;
+}
+
+
+template <typename T>
+basicSharedMix<T>::~basicSharedMix()
+{
+	detach();
+}
+
+
+template <typename T>
+typename basicSharedMix<T>::mixResult basicSharedMix<T>::ping()
+{
+	const int SIZE = 10;
+	mixResult returnset(SIZE);
+	segmentHeader* pHeader = header();
+	std::uint32_t top = pHeader->activeCount.load(std::memory_order_relaxed);
+	while (top > 0) {
+		if (pingSlot(top - 1, returnset)) {
+			return returnset;
+		}
+		// retire it, unless another ping already has, then retry from the
+		// new top either way
+		pHeader->activeCount.compare_exchange_strong(
+			top, top - 1, std::memory_order_relaxed);
+		top = pHeader->activeCount.load(std::memory_order_relaxed);
+	}
+	returnset.clear();
+	return returnset;
+}
+
+
+template <typename T>
+typename basicSharedMix<T>::mixResult
+basicSharedMix<T>::ping(std::size_t index)
+{
+	const int SIZE = 10;
+	mixResult returnset(SIZE);
+	if (!pingSlot(index, returnset)) {
+		returnset.clear();
+	}
+	return returnset;
+}
+
+
+template <typename T>
+bool basicSharedMix<T>::remove(const std::string& name)
+{
+#if defined(SHARED_MIX_POSIX)
+	return (shm_unlink(name.c_str()) == 0);
+#else
+	(void)name;
+	return false;
+#endif
+}
+
+
+template <typename T>
+std::vector<T> basicSharedMix<T>::dataset(std::size_t index) const
+{
+	const mixerRecord& rRecord = records()[index];
+	const T* pFirst = values() + rRecord.datasetOffset;
+	return std::vector<T>(pFirst, pFirst + rRecord.datasetSize);
+}
+
+
+template <typename T>
+void basicSharedMix<T>::seed(std::uint32_t seed)
+{
+	processEngine().seed(seed);
+}
+
+
+template <typename T>
+bool basicSharedMix<T>::pingSlot(std::size_t index, mixResult& returnset)
+{
+	mixerRecord& rRecord = records()[index];
+	bool valid = false;
+	switch (index % 3) {
+		case 0:
+			valid = (rRecord.datasetSize > 0);
+			break;
+		case 1:
+			valid = (rRecord.evenCount > 0);
+			break;
+		case 2:
+			valid = (rRecord.oddCount > 0);
+			break;
+	}
+	std::int32_t countDown = rRecord.countDown.load(std::memory_order_relaxed);
+	do {
+		if (!valid || countDown <= 0) {
+			return false;
+		}
+	} while (!rRecord.countDown.compare_exchange_weak(
+				 countDown, countDown - 1, std::memory_order_relaxed));
+
+	const T* pDataset = values() + rRecord.datasetOffset;
+	std::mt19937& eng = processEngine();
+	std::uniform_int_distribution<unsigned int> distr(
+		0, rRecord.datasetSize - 1);
+	for (std::size_t i = 0; i < returnset.size(); ++i) {
+		T val = pDataset[distr(eng)];
+		if (index % 3 == 1) {
+			while (mixValueTraits<T>::isOdd(val)) {
+				val = pDataset[distr(eng)];
+			}
+		} else if (index % 3 == 2) {
+			while (!mixValueTraits<T>::isOdd(val)) {
+				val = pDataset[distr(eng)];
+			}
+		}
+		returnset[i] = val;
+	}
+
+	if (index % 3 == 0) {
+		// "Mix" pings have their primes removed, as in multiMix
+		static const basicMixPipeline<T> PRIME_PURGE =
+			basicMixPipeline<T>::primePurge();
+		PRIME_PURGE.apply(returnset);
+	}
+	return true;
+}
+
+
+template <typename T>
+void basicSharedMix<T>::detach()
+{
+#if defined(SHARED_MIX_POSIX)
+	if (_segment) {
+		munmap(_segment, _bytes);
+	}
+#endif
+	_name.clear();
+	_segment = 0;
+	_bytes = 0;
+}
+
+
+template class basicSharedMix<std::int16_t>;
+template class basicSharedMix<int>;
+template class basicSharedMix<std::int64_t>;
\ No newline at end of file
@@ -0,0 +1,214 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: streamMix.cpp
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// Implementation Invariant:
+// * Even values fill "_buffer" from index 0 up, odd values from the last
+// index down, so the partitions never overlap while the sample holds at most
+// capacity() values.
+// * Sample value number i is "_buffer"[i] for i < "_evenCount", and
+// "_buffer"[capacity() - 1 - (i - "_evenCount")] otherwise.
+// * drawUnit() never returns 0, so "_w" only shrinks by a finite factor.
+// drawSkip() maps a NaN or negative skip to 0, and caps it at 1e18, so its
+// cast to an integer is always defined.
+// * Only the ingesting thread writes the sample, "_w", "_skip" and "_kept", so
+// it may read "_kept" without the lock.
+
+
+#include <cmath>  // exp, log, log1p, floor
+#include <cstdint>  // int16_t, int64_t, uint64_t
+#include <mutex>  // mutex, lock_guard
+#include <random>  // mt19937, uniform_int_distribution,
+					// generate_canonical
+#include <utility>  // move
+#include <vector>  // vector
+
+
+#include "../include/mixSeed.h"
+#include "../include/mixValue.h"
+#include "../include/numMixer.h"
+#include "../include/streamMix.h"
+
+
+template <typename T>
+thread_local std::mt19937 basicStreamMix<T>::_eng = seedThreadEngine();
+
+
+template <typename T>
+basicStreamMix<T>::basicStreamMix(unsigned int capacity):
+	_buffer(capacity),
+	_evenCount(0),
+	_oddCount(0),
+	_lock(),
+	_ingestEng(seedThreadEngine()),
+	_w(1.0),
+	_skip(0),
+	_seen(0),
+	_kept(0)
+{
+}
+
+
+template <typename T>
+bool basicStreamMix<T>::ping(std::vector<T>& returnValues,
+							 OutputController parity)
+{
+	return ping(returnValues.data(), returnValues.size(), parity);
+}
+
+
+template <typename T>
+bool basicStreamMix<T>::ping(T* returnValues, unsigned int size,
+							 OutputController parity)
+{
+	std::lock_guard<std::mutex> lock(_lock);
+	unsigned int count = _evenCount + _oddCount;
+	if (parity == numMixer::EVEN) {
+		count = _evenCount;
+	} else if (parity == numMixer::ODD) {
+		count = _oddCount;
+	}
+	if (count == 0) {
+		return false;
+	}
+
+	// odd values are counted down from the back, after any even values
+	const unsigned int BACK = _buffer.size() - 1 + _evenCount;
+	const unsigned int FIRST = (parity == numMixer::ODD) ? _evenCount : 0;
+	std::uniform_int_distribution<unsigned int> distr(FIRST,
+													  FIRST + count - 1);
+	for (unsigned int i = 0; i < size; ++i) {
+		unsigned int slot = distr(_eng);
+		returnValues[i] = (slot < _evenCount) ? _buffer[slot]
+											  : _buffer[BACK - slot];
+	}
+	return true;
+}
+
+
+template <typename T>
+typename basicStreamMix<T>::numMixer basicStreamMix<T>::snapshot() const
+{
+	std::vector<T> dataset;
+	{
+		std::lock_guard<std::mutex> lock(_lock);
+		dataset.reserve(_evenCount + _oddCount);
+		dataset.insert(dataset.end(), _buffer.begin(),
+					   _buffer.begin() + _evenCount);
+		dataset.insert(dataset.end(), _buffer.end() - _oddCount,
+					   _buffer.end());
+	}
+	return numMixer(std::move(dataset));
+}
+
+
+template <typename T>
+unsigned int basicStreamMix<T>::size() const
+{
+	std::lock_guard<std::mutex> lock(_lock);
+	return _evenCount + _oddCount;
+}
+
+
+template <typename T>
+unsigned int basicStreamMix<T>::evenCount() const
+{
+	std::lock_guard<std::mutex> lock(_lock);
+	return _evenCount;
+}
+
+
+template <typename T>
+unsigned int basicStreamMix<T>::oddCount() const
+{
+	std::lock_guard<std::mutex> lock(_lock);
+	return _oddCount;
+}
+
+
+template <typename T>
+void basicStreamMix<T>::keep(T val)
+{
+	const std::uint64_t KEPT = _kept.load(std::memory_order_relaxed);
+	if (KEPT < _buffer.size()) {
+		// filling up, every value is kept
+		std::lock_guard<std::mutex> lock(_lock);
+		insertValue(val);
+	} else {
+		std::uniform_int_distribution<unsigned int> distr(
+			0, _buffer.size() - 1);
+		unsigned int slot = distr(_ingestEng);
+		std::lock_guard<std::mutex> lock(_lock);
+		removeSlot(slot);
+		insertValue(val);
+	}
+	_kept.store(KEPT + 1, std::memory_order_relaxed);
+	if (KEPT + 1 >= _buffer.size()) {
+		drawSkip();
+	}
+}
+
+
+template <typename T>
+void basicStreamMix<T>::insertValue(T val)
+{
+	if (mixValueTraits<T>::isOdd(val)) {
+		_buffer[_buffer.size() - 1 - _oddCount] = val;
+		++_oddCount;
+	} else {
+		_buffer[_evenCount] = val;
+		++_evenCount;
+	}
+}
+
+
+template <typename T>
+void basicStreamMix<T>::removeSlot(unsigned int slot)
+{
+	// move the innermost value of the partition into the gap
+	if (slot < _evenCount) {
+		--_evenCount;
+		_buffer[slot] = _buffer[_evenCount];
+	} else {
+		const unsigned int BACK = _buffer.size() - 1;
+		--_oddCount;
+		_buffer[BACK - (slot - _evenCount)] = _buffer[BACK - _oddCount];
+	}
+}
+
+
+template <typename T>
+void basicStreamMix<T>::drawSkip()
+{
+	// the sample holds the values with the smallest uniform keys, "_w" is
+	// the largest of those, and the next key below it is a geometric amount
+	// of values away
+	const double MAX_SKIP = 1e18;
+	_w *= std::exp(std::log(drawUnit()) / _buffer.size());
+	double skip = std::floor(std::log(drawUnit()) / std::log1p(-_w));
+	if (!(skip >= 0.0)) {
+		// NaN or negative
+		skip = 0.0;
+	}
+	_skip = (skip < MAX_SKIP) ? static_cast<std::uint64_t>(skip)
+							  : static_cast<std::uint64_t>(MAX_SKIP);
+}
+
+
+template <typename T>
+double basicStreamMix<T>::drawUnit()
+{
+	// generate_canonical may return 1.0 (LWG 2524), which would be a 0 here
+	double unit;
+	do {
+		unit = 1.0 - std::generate_canonical<double, 53>(_ingestEng);
+	} while (unit <= 0.0);
+	return unit;
+}
+
+
+template class basicStreamMix<std::int16_t>;
+template class basicStreamMix<int>;
+template class basicStreamMix<std::int64_t>;
\ No newline at end of file
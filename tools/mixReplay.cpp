@@ -0,0 +1,135 @@
+// AUTHOR: Ryan McKenzie
+// FILENAME: mixReplay.cpp
+// DATE: October 18, 2026
+// REVISION HISTORY: v1.0.0
+// PLATFORM: GCC v7.1.0
+
+// DESCRIPTION:
+// * Replays a mixer log recorded by mixRecorder, and checks that the replayed
+// output matches the recorded output.
+// * Usage:
+//   mixReplay <log>             replays <log>
+//   mixReplay --demo <log> [n]  records <n> operations of synthetic traffic to
+//                               <log>, for trying the tool out
+
+// ASSUMPTIONS:
+// * Exits with 0 if the replay matches, 1 if it diverges or the log is
+// malformed, 2 on bad usage.
+
+
+#include <chrono>  // steady_clock
+#include <cstdlib>  // strtoul
+#include <ctime>  // time
+#include <fstream>  // ifstream, ofstream
+#include <iostream>  // cout, cerr
+#include <string>  // string
+#include <vector>  // vector
+
+
+#include "../include/mixRecorder.h"
+#include "../include/multiMix.h"
+#include "../include/numMixer.h"
+
+
+int recordDemo(const char* path, unsigned long operations);
+// Description:
+// * Records "operations" operations of synthetic traffic to "path".
+
+
+int replay(const char* path);
+// Description:
+// * Replays the log at "path", and prints the outcome.
+
+
+int main(int argc, char* argv[])
+{
+	if (argc >= 3 && std::string(argv[1]) == "--demo") {
+		unsigned long operations = (argc >= 4 ?
+									std::strtoul(argv[3], nullptr, 10) :
+									1000000);
+		return recordDemo(argv[2], operations);
+	}
+	if (argc == 2) {
+		return replay(argv[1]);
+	}
+	std::cerr << "usage: mixReplay <log>" << std::endl
+			  << "       mixReplay --demo <log> [operations]" << std::endl;
+	return 2;
+}
+
+
+int recordDemo(const char* path, unsigned long operations)
+{
+	std::ofstream log(path, std::ios::binary);
+	if (!log) {
+		std::cerr << "can not write " << path << std::endl;
+		return 1;
+	}
+
+	mixRecorder recorder(&log, time(0));
+	unsigned int mm = recorder.createMultiMix();
+	unsigned int dm = recorder.createDubMix();
+	unsigned int nm = recorder.createNumMixer({ 1, 2, 3, 4, 5, 6, 7, 8, 9 });
+	recorder.addNumMixers(mm, 64);
+	recorder.setSchedulePolicy(mm, multiMix::ROUND_ROBIN);
+	std::vector<int> returnValues(10);
+	for (unsigned long i = 0; recorder.operations() < operations; ++i) {
+		switch (i % 8) {
+			case 0:
+				recorder.addNumMixers(mm, 4);
+				break;
+			case 1:
+				recorder.removeNumMixers(mm, 2);
+				break;
+			case 2:
+				recorder.setCtl(dm, 3 + i / 8 % 2);
+				break;
+			case 3:
+				recorder.pingDubMix(dm, 10);
+				break;
+			case 4:
+				recorder.setControllerState(
+						nm, static_cast<numMixer::OutputController>(i / 8 % 3));
+				break;
+			case 5:
+				recorder.pingNumMixer(nm, returnValues);
+				break;
+			default:
+				recorder.pingMultiMix(mm);
+				break;
+		}
+	}
+	recorder.finish();
+	std::cout << "recorded " << recorder.operations() << " operations, seed "
+			  << recorder.seed() << ", checksum " << std::hex
+			  << recorder.checksum() << std::dec << std::endl;
+	return 0;
+}
+
+
+int replay(const char* path)
+{
+	std::ifstream log(path, std::ios::binary);
+	if (!log) {
+		std::cerr << "can not read " << path << std::endl;
+		return 1;
+	}
+
+	mixReplayer replayer(log);
+	auto start = std::chrono::steady_clock::now();
+	bool matched = replayer.run();
+	auto stop = std::chrono::steady_clock::now();
+	double seconds = std::chrono::duration<double>(stop - start).count();
+
+	if (!matched) {
+		std::cerr << "replay failed: " << replayer.error() << std::endl;
+		return 1;
+	}
+	std::cout << "replayed " << replayer.operations() << " operations, seed "
+			  << replayer.seed() << ", checksum " << std::hex
+			  << replayer.checksum() << std::dec << " (match), in "
+			  << seconds << " s, "
+			  << replayer.operations() / seconds << " operations/s"
+			  << std::endl;
+	return 0;
+}
\ No newline at end of file